@@ -0,0 +1,526 @@
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/cnr_yaml.h>
+#include <cnr_yaml/document.h>
+#include <cnr_yaml/generator.h>
+#include <cnr_yaml/node_utils.h>
+#include <cnr_yaml/static_key.h>
+#include <cnr_yaml/warmup.h>
+
+#include "heap_counter.h"
+
+// The benchmarks of the hot paths of the library. Run with
+//   bench_cnr_yaml --benchmark_out=bench_cnr_yaml.json --benchmark_out_format=json
+// (or build the target bench_cnr_yaml_json), and compare two runs with the compare.py of Google Benchmark.
+
+namespace
+{
+
+/**
+ * @brief A map of the given depth, where each level has 'width' keys k0 ... k<width-1>. The leaves are doubles.
+ */
+YAML::Node make_tree(std::size_t width, std::size_t depth, double value = 1.0)
+{
+  YAML::Node node(YAML::NodeType::Map);
+  for (std::size_t i = 0; i < width; i++)
+  {
+    if (depth <= 1)
+    {
+      node["k" + std::to_string(i)] = value + double(i);
+    }
+    else
+    {
+      node["k" + std::to_string(i)] = make_tree(width, depth - 1, value);
+    }
+  }
+  return node;
+}
+
+/**
+ * @brief The key k0/k0/.../k0 of the given depth
+ */
+std::string make_key(std::size_t depth)
+{
+  std::string key;
+  for (std::size_t i = 0; i < depth; i++)
+  {
+    key += (i == 0 ? "k0" : "/k0");
+  }
+  return key;
+}
+
+template <typename T>
+void BM_Get(benchmark::State& state, const char* yaml)
+{
+  const YAML::Node node = YAML::Load(yaml);
+  const bool implicit_cast = state.range(0) != 0;
+  std::string what;
+  T value{};
+  for (auto _ : state)
+  {
+    bool ok = cnr::yaml::get(node, value, what, implicit_cast);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetLabel(implicit_cast ? "implicit_cast" : "no_implicit_cast");
+}
+
+template <typename T>
+void BM_Set(benchmark::State& state, T value)
+{
+  std::string what;
+  for (auto _ : state)
+  {
+    YAML::Node node;
+    bool ok = cnr::yaml::set(value, node, what);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(node);
+  }
+}
+
+void BM_GetLeaf(benchmark::State& state)
+{
+  const std::size_t depth = static_cast<std::size_t>(state.range(0));
+  const YAML::Node root = make_tree(4, depth);
+  const std::string key = make_key(depth);
+  std::string what;
+  for (auto _ : state)
+  {
+    YAML::Node leaf;
+    bool ok = cnr::yaml::get_leaf(root, key, leaf, what);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(leaf);
+  }
+}
+
+/**
+ * @brief The result of merge_nodes shares the memory of the inputs (with the same inputs the memory grows at each
+ * iteration): the inputs are cloned in batches, and only the merges of a batch are timed, with a steady_clock
+ * (UseManualTime). The time reported is the time of one merge (the CPU time includes the clones).
+ */
+constexpr std::size_t merge_batch_size = 16;
+
+void merge_batch(benchmark::State& state, const YAML::Node& defaults, const YAML::Node& overrides)
+{
+  std::vector<std::pair<YAML::Node, YAML::Node>> inputs;
+  inputs.reserve(merge_batch_size);
+  for (std::size_t i = 0; i < merge_batch_size; i++)
+  {
+    inputs.emplace_back(YAML::Clone(defaults), YAML::Clone(overrides));
+  }
+  std::vector<YAML::Node> merged(merge_batch_size);
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < merge_batch_size; i++)
+  {
+    merged[i] = cnr::yaml::merge_nodes(inputs[i].first, inputs[i].second);
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  benchmark::DoNotOptimize(merged.data());
+  state.SetIterationTime(elapsed.count() / merge_batch_size);
+}
+
+void BM_MergeNodesByWidth(benchmark::State& state)
+{
+  const std::size_t width = static_cast<std::size_t>(state.range(0));
+  const YAML::Node defaults = make_tree(width, 2, 1.0);
+  const YAML::Node overrides = make_tree(width, 2, 2.0);
+  for (auto _ : state)
+  {
+    merge_batch(state, defaults, overrides);
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_MergeNodesByDepth(benchmark::State& state)
+{
+  const std::size_t depth = static_cast<std::size_t>(state.range(0));
+  const YAML::Node defaults = make_tree(2, depth, 1.0);
+  const YAML::Node overrides = make_tree(2, depth, 2.0);
+  for (auto _ : state)
+  {
+    merge_batch(state, defaults, overrides);
+  }
+}
+
+void BM_GetKeysTree(benchmark::State& state)
+{
+  const YAML::Node root = make_tree(static_cast<std::size_t>(state.range(0)), 3);
+  for (auto _ : state)
+  {
+    std::vector<std::string> tree;
+    cnr::yaml::get_keys_tree("", root, tree);
+    benchmark::DoNotOptimize(tree);
+  }
+  state.SetComplexityN(state.range(0) * state.range(0) * state.range(0));
+}
+
+void BM_ToNodeList(benchmark::State& state)
+{
+  const YAML::Node root = make_tree(static_cast<std::size_t>(state.range(0)), 3);
+  for (auto _ : state)
+  {
+    auto list = cnr::yaml::toNodeList(root);
+    benchmark::DoNotOptimize(list);
+  }
+  state.SetComplexityN(state.range(0) * state.range(0) * state.range(0));
+}
+
+/**
+ * @brief A synthetic configuration of about n nodes, as text (50 MB for 3M nodes)
+ */
+std::string generated_text(std::size_t n)
+{
+  cnr::yaml::GeneratorOptions options;
+  options.seed = 1;
+  options.breadth = 16;
+  options.depth = 8;
+  options.map_weight = 1.0;
+  options.max_nodes = n;
+  return std::to_string(cnr::yaml::generate_tree(options));
+}
+
+/**
+ * @brief The memory of the result of a parse, measured in the same way for all the parsers, outside the timed loop:
+ * the heap in use by the result (memory_bytes) and the peak of the heap during the parse (peak_bytes), both relative
+ * to the heap in use before the parse
+ */
+template <typename Parse>
+void set_memory_counters(benchmark::State& state, const Parse& parse)
+{
+  const std::size_t before = cnr_yaml_bench::heap_in_use();
+  cnr_yaml_bench::reset_heap_peak();
+  {
+    auto result = parse();
+    state.counters["memory_bytes"] = static_cast<double>(cnr_yaml_bench::heap_in_use() - before);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["peak_bytes"] = static_cast<double>(cnr_yaml_bench::heap_peak() - before);
+}
+
+void BM_LoadGenerated(benchmark::State& state)
+{
+  const std::string text = generated_text(static_cast<std::size_t>(state.range(0)));
+  set_memory_counters(state, [&text]() { return YAML::Load(text); });
+  for (auto _ : state)
+  {
+    YAML::Node node = YAML::Load(text);
+    benchmark::DoNotOptimize(node);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+  state.SetComplexityN(state.range(0));
+  state.counters["text_bytes"] = static_cast<double>(text.size());
+}
+
+/**
+ * @brief The same configurations of BM_LoadGenerated parsed into a Document (a frozen tree, without the YAML::Node)
+ */
+void BM_DocumentParse(benchmark::State& state)
+{
+  const std::string text = generated_text(static_cast<std::size_t>(state.range(0)));
+  std::string what;
+  bool parsed = false;
+  set_memory_counters(state, [&]() {
+    auto doc = std::make_unique<cnr::yaml::Document>();
+    parsed = doc->parse(text, what);
+    return doc;
+  });
+  if (!parsed)
+  {
+    state.SkipWithError(what.c_str());
+    return;
+  }
+  for (auto _ : state)
+  {
+    cnr::yaml::Document doc;
+    bool ok = doc.parse(text, what);
+    benchmark::DoNotOptimize(ok);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+  state.SetComplexityN(state.range(0));
+  state.counters["text_bytes"] = static_cast<double>(text.size());
+}
+
+void BM_GetLeafRobotCell(benchmark::State& state)
+{
+  cnr::yaml::RobotCellOptions options;
+  options.robots = static_cast<std::size_t>(state.range(0));
+  const YAML::Node cell = cnr::yaml::generate_robot_cell(options);
+  const std::string key = "cell/robots/robot_" + std::to_string(options.robots - 1) + "/arms/arm_1/limits/velocity";
+  std::string what;
+  for (auto _ : state)
+  {
+    YAML::Node leaf;
+    bool ok = cnr::yaml::get_leaf(cell, key, leaf, what);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(leaf);
+  }
+}
+
+/**
+ * @brief The first access to a key of a freshly loaded tree (resolve and decode), and the same access after warmup (a
+ * lookup in the cache). The fresh trees are prepared in batches, and only the accesses of a batch are timed, with a
+ * steady_clock (UseManualTime): a PauseTiming/ResumeTiming pair costs more than the whole batch. The time reported
+ * is the time of one access (the CPU time includes the preparation, and it is meaningless).
+ */
+const std::string first_access_key = "cell/robots/robot_0/arms/arm_1/limits/velocity";
+constexpr std::size_t first_access_batch = 64;
+
+void set_access_time(benchmark::State& state, const std::chrono::steady_clock::time_point& start)
+{
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  state.SetIterationTime(elapsed.count() / first_access_batch);
+}
+
+void BM_FirstAccessCold(benchmark::State& state)
+{
+  const YAML::Node cell = cnr::yaml::generate_robot_cell(cnr::yaml::RobotCellOptions());
+  std::string what;
+  std::vector<cnr::yaml::FrozenNode> roots;
+  for (auto _ : state)
+  {
+    roots.clear();
+    for (std::size_t i = 0; i < first_access_batch; i++)
+    {
+      roots.emplace_back(cell);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& root : roots)
+    {
+      cnr::yaml::FrozenNode leaf;
+      Eigen::VectorXd value;
+      bool ok = cnr::yaml::get_leaf(root, first_access_key, leaf, what) && cnr::yaml::get(leaf, value, what, true);
+      benchmark::DoNotOptimize(ok);
+      benchmark::DoNotOptimize(value.data());
+    }
+    set_access_time(state, start);
+  }
+}
+
+void BM_FirstAccessWarm(benchmark::State& state)
+{
+  const YAML::Node cell = cnr::yaml::generate_robot_cell(cnr::yaml::RobotCellOptions());
+  cnr::yaml::register_numeric_warmup_types();
+  const cnr::yaml::Manifest manifest{ { first_access_key, "Eigen::VectorXd" } };
+  const cnr::yaml::KeyPath path(first_access_key);
+  std::string what;
+  std::vector<cnr::yaml::WarmCache> caches;
+  for (auto _ : state)
+  {
+    caches.clear();
+    caches.resize(first_access_batch);
+    for (auto& cache : caches)
+    {
+      if (!cnr::yaml::warmup(cnr::yaml::FrozenNode(cell), manifest, cache, what))
+      {
+        state.SkipWithError(what.c_str());
+        return;
+      }
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& cache : caches)
+    {
+      const Eigen::VectorXd* value = cache.find<Eigen::VectorXd>(path);
+      benchmark::DoNotOptimize(value);
+    }
+    set_access_time(state, start);
+  }
+}
+
+/**
+ * @brief The first read of a warm value through the pointer taken after the warm-up, as the real-time threads do
+ * (see WarmCache): no lookup, only the value itself is read
+ */
+void BM_FirstAccessHandle(benchmark::State& state)
+{
+  const YAML::Node cell = cnr::yaml::generate_robot_cell(cnr::yaml::RobotCellOptions());
+  cnr::yaml::register_numeric_warmup_types();
+  const cnr::yaml::Manifest manifest{ { first_access_key, "Eigen::VectorXd" } };
+  const cnr::yaml::KeyPath path(first_access_key);
+  std::string what;
+  std::vector<cnr::yaml::WarmCache> caches;
+  std::vector<const Eigen::VectorXd*> handles;
+  for (auto _ : state)
+  {
+    caches.clear();
+    caches.resize(first_access_batch);
+    handles.clear();
+    for (auto& cache : caches)
+    {
+      if (!cnr::yaml::warmup(cnr::yaml::FrozenNode(cell), manifest, cache, what))
+      {
+        state.SkipWithError(what.c_str());
+        return;
+      }
+    }
+    for (const auto& cache : caches)
+    {
+      handles.push_back(cache.find<Eigen::VectorXd>(path));
+    }
+    // the lookups touch the slots, not the coefficients of the vectors, that are read first in the timed loop
+    const auto start = std::chrono::steady_clock::now();
+    for (const Eigen::VectorXd* value : handles)
+    {
+      double v = (*value)(0);
+      benchmark::DoNotOptimize(v);
+    }
+    set_access_time(state, start);
+  }
+}
+
+/**
+ * @brief The steady state of the warm access: the lookup of the key in a cache already touched
+ */
+void BM_SteadyStateWarm(benchmark::State& state)
+{
+  const YAML::Node cell = cnr::yaml::generate_robot_cell(cnr::yaml::RobotCellOptions());
+  cnr::yaml::register_numeric_warmup_types();
+  const cnr::yaml::Manifest manifest{ { first_access_key, "Eigen::VectorXd" } };
+  const cnr::yaml::KeyPath path(first_access_key);
+  std::string what;
+  cnr::yaml::WarmCache cache;
+  if (!cnr::yaml::warmup(cnr::yaml::FrozenNode(cell), manifest, cache, what))
+  {
+    state.SkipWithError(what.c_str());
+    return;
+  }
+  for (auto _ : state)
+  {
+    const Eigen::VectorXd* value = cache.find<Eigen::VectorXd>(path);
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+/**
+ * @brief The steady state of the cold access: resolve and decode on a tree already touched
+ */
+void BM_SteadyState(benchmark::State& state)
+{
+  const YAML::Node cell = cnr::yaml::generate_robot_cell(cnr::yaml::RobotCellOptions());
+  const cnr::yaml::FrozenNode root(cell);
+  std::string what;
+  Eigen::VectorXd value;
+  for (auto _ : state)
+  {
+    cnr::yaml::FrozenNode leaf;
+    bool ok = cnr::yaml::get_leaf(root, first_access_key, leaf, what) && cnr::yaml::get(leaf, value, what, true);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(value.data());
+  }
+}
+
+/**
+ * @brief get_leaf of a key of the robot cell, with the key tokenized at runtime (argument 0) or at compile time with
+ * cnr::yaml::key<"..."> (argument 1)
+ */
+template <typename Node>
+void BM_GetLeafStaticKey(benchmark::State& state)
+{
+  const YAML::Node cell = cnr::yaml::generate_robot_cell(cnr::yaml::RobotCellOptions());
+  const Node root(cell);
+  const bool static_key = state.range(0) != 0;
+  const std::string key = "cell/robots/robot_0/arms/arm_1/limits/velocity";
+  std::string what;
+  for (auto _ : state)
+  {
+    Node leaf;
+    bool ok = static_key ? cnr::yaml::get_leaf(root, cnr::yaml::key<"cell/robots/robot_0/arms/arm_1/limits/velocity">,
+                                               leaf, what)
+                         : cnr::yaml::get_leaf(root, key, leaf, what);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(leaf);
+  }
+}
+
+}  // namespace
+
+// get_leaf: the argument is the depth of the key
+BENCHMARK(BM_GetLeaf)->DenseRange(1, 7, 2);
+
+// merge_nodes: the argument is the width (on two levels), or the depth (of a binary tree)
+BENCHMARK(BM_MergeNodesByWidth)->RangeMultiplier(4)->Range(4, 64)->Complexity()->UseManualTime();
+BENCHMARK(BM_MergeNodesByDepth)->DenseRange(1, 6, 1)->UseManualTime();
+
+// get_keys_tree / toNodeList: the argument is the width of a tree of depth 3 (width^3 leaves)
+BENCHMARK(BM_GetKeysTree)->RangeMultiplier(2)->Range(2, 16)->Complexity();
+BENCHMARK(BM_ToNodeList)->RangeMultiplier(2)->Range(2, 16)->Complexity();
+
+// synthetic configurations (see cnr_yaml/generator.h): the argument is the number of nodes, or of robots
+// the counters report the size of the text and the memory of the tree (the heap footprint of the YAML::Node, the
+// blob of the Document)
+BENCHMARK(BM_LoadGenerated)->Arg(10000)->Arg(100000)->Arg(1000000)->Arg(3000000)->Unit(benchmark::kMillisecond)->Complexity();
+BENCHMARK(BM_DocumentParse)->Arg(10000)->Arg(100000)->Arg(1000000)->Arg(3000000)->Unit(benchmark::kMillisecond)->Complexity();
+BENCHMARK(BM_GetLeafRobotCell)->RangeMultiplier(4)->Range(1, 64);
+
+// warmup (see cnr_yaml/warmup.h): the first access is compared with the steady state of the same kind of access
+// the untimed setup is much longer than the accesses, so the iterations are fixed
+BENCHMARK(BM_FirstAccessCold)->Iterations(200)->UseManualTime();
+BENCHMARK(BM_SteadyState);
+BENCHMARK(BM_FirstAccessWarm)->Iterations(200)->UseManualTime();
+BENCHMARK(BM_SteadyStateWarm);
+BENCHMARK(BM_FirstAccessHandle)->Iterations(200)->UseManualTime();
+
+int main(int argc, char** argv)
+{
+  // BENCHMARK_CAPTURE does not accept a template function: the typed benchmarks are registered here
+  // get<T>: the argument is the implicit_cast_if_possible flag
+  benchmark::RegisterBenchmark("BM_Get<double>", BM_Get<double>, "3.14")->Arg(0)->Arg(1);
+  benchmark::RegisterBenchmark("BM_Get<double>/from_int", BM_Get<double>, "3")->Arg(0)->Arg(1);
+  benchmark::RegisterBenchmark("BM_Get<int>", BM_Get<int>, "42")->Arg(0)->Arg(1);
+  benchmark::RegisterBenchmark("BM_Get<bool>", BM_Get<bool>, "true")->Arg(0)->Arg(1);
+  benchmark::RegisterBenchmark("BM_Get<string>", BM_Get<std::string>, "a_string")->Arg(0)->Arg(1);
+  benchmark::RegisterBenchmark("BM_Get<vector<double>>", BM_Get<std::vector<double>>,
+                               "[1.0, 2.0, 3.0, 4.0, 5.0, 6.0]")
+      ->Arg(0)
+      ->Arg(1);
+  benchmark::RegisterBenchmark("BM_Get<vector<vector<double>>>", BM_Get<std::vector<std::vector<double>>>,
+                               "[[1.0, 2.0], [3.0, 4.0]]")
+      ->Arg(0)
+      ->Arg(1);
+  benchmark::RegisterBenchmark("BM_Get<array<double,6>>", BM_Get<std::array<double, 6>>,
+                               "[1.0, 2.0, 3.0, 4.0, 5.0, 6.0]")
+      ->Arg(0)
+      ->Arg(1);
+  benchmark::RegisterBenchmark("BM_Get<VectorXd>", BM_Get<Eigen::VectorXd>, "[1.0, 2.0, 3.0, 4.0, 5.0, 6.0]")
+      ->Arg(0)
+      ->Arg(1);
+  benchmark::RegisterBenchmark("BM_Get<Vector3d>", BM_Get<Eigen::Vector3d>, "[1.0, 2.0, 3.0]")->Arg(0)->Arg(1);
+  benchmark::RegisterBenchmark("BM_Get<MatrixXd>", BM_Get<Eigen::MatrixXd>,
+                               "[[1.0, 2.0, 3.0], [4.0, 5.0, 6.0], [7.0, 8.0, 9.0]]")
+      ->Arg(0)
+      ->Arg(1);
+
+  // get_leaf with a runtime or a static key: the argument is 0 (runtime) or 1 (static)
+  benchmark::RegisterBenchmark("BM_GetLeafStaticKey<YAML::Node>", BM_GetLeafStaticKey<YAML::Node>)->Arg(0)->Arg(1);
+  benchmark::RegisterBenchmark("BM_GetLeafStaticKey<FrozenNode>", BM_GetLeafStaticKey<cnr::yaml::FrozenNode>)
+      ->Arg(0)
+      ->Arg(1);
+
+  // set<T>
+  benchmark::RegisterBenchmark("BM_Set<double>", BM_Set<double>, 3.14);
+  benchmark::RegisterBenchmark("BM_Set<int>", BM_Set<int>, 42);
+  benchmark::RegisterBenchmark("BM_Set<string>", BM_Set<std::string>, std::string("a_string"));
+  benchmark::RegisterBenchmark("BM_Set<vector<double>>", BM_Set<std::vector<double>>,
+                               std::vector<double>{ 1, 2, 3, 4, 5, 6 });
+  benchmark::RegisterBenchmark("BM_Set<VectorXd>", BM_Set<Eigen::VectorXd>,
+                               Eigen::VectorXd(Eigen::VectorXd::LinSpaced(6, 1.0, 6.0)));
+  benchmark::RegisterBenchmark("BM_Set<MatrixXd>", BM_Set<Eigen::MatrixXd>,
+                               Eigen::MatrixXd(Eigen::MatrixXd::Identity(3, 3)));
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+  {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+#include "heap_counter.h"
+
+namespace
+{
+// constant-initialized: they can be used by the allocations of the static constructors
+std::atomic<std::size_t> in_use{ 0 };
+std::atomic<std::size_t> peak{ 0 };
+
+void* counted(void* p)
+{
+  if (!p)
+  {
+    throw std::bad_alloc();
+  }
+  const std::size_t now = in_use.fetch_add(malloc_usable_size(p), std::memory_order_relaxed) + malloc_usable_size(p);
+  std::size_t max = peak.load(std::memory_order_relaxed);
+  while (now > max && !peak.compare_exchange_weak(max, now, std::memory_order_relaxed))
+  {
+  }
+  return p;
+}
+
+void* allocate(std::size_t size)
+{
+  return counted(std::malloc(size ? size : 1));
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment)
+{
+  const std::size_t a = static_cast<std::size_t>(alignment);
+  return counted(std::aligned_alloc(a, (size + a - 1) / a * a));
+}
+
+void deallocate(void* p) noexcept
+{
+  if (p)
+  {
+    in_use.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+  }
+  std::free(p);
+}
+}  // namespace
+
+namespace cnr_yaml_bench
+{
+std::size_t heap_in_use()
+{
+  return in_use.load(std::memory_order_relaxed);
+}
+
+std::size_t heap_peak()
+{
+  return peak.load(std::memory_order_relaxed);
+}
+
+void reset_heap_peak()
+{
+  peak.store(in_use.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+}  // namespace cnr_yaml_bench
+
+void* operator new(std::size_t size)
+{
+  return allocate(size);
+}
+void* operator new[](std::size_t size)
+{
+  return allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  return allocate(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return allocate(size, alignment);
+}
+void operator delete(void* p) noexcept
+{
+  deallocate(p);
+}
+void operator delete[](void* p) noexcept
+{
+  deallocate(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+  deallocate(p);
+}
+void operator delete[](void* p, std::size_t) noexcept
+{
+  deallocate(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
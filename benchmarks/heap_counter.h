@@ -0,0 +1,23 @@
+#ifndef CNR_YAML_UTILITIES__BENCHMARKS__HEAP_COUNTER__H
+#define CNR_YAML_UTILITIES__BENCHMARKS__HEAP_COUNTER__H
+
+#include <cstddef>
+
+namespace cnr_yaml_bench
+{
+
+/**
+ * @brief The bytes of the heap blocks allocated by the global operator new (replaced in heap_counter.cpp) and not yet
+ * released, counted with their usable size, as the allocator sees them
+ */
+std::size_t heap_in_use();
+
+/**
+ * @brief The largest heap_in_use since the last reset_heap_peak
+ */
+std::size_t heap_peak();
+void reset_heap_peak();
+
+}  // namespace cnr_yaml_bench
+
+#endif  // CNR_YAML_UTILITIES__BENCHMARKS__HEAP_COUNTER__H
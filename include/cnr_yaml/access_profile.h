@@ -0,0 +1,175 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__ACCESS_PROFILE__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__ACCESS_PROFILE__H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief A latency histogram with logarithmic buckets, in the HDR style: each power of two is split in 8 linear
+ * sub-buckets, so that the relative error of a percentile is below 12.5% from 1 ns to 1100 s.
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr std::size_t SUB_BITS = 3;
+  static constexpr std::size_t SUB_BUCKETS = std::size_t(1) << SUB_BITS;
+  static constexpr std::size_t OCTAVES = 40;
+  static constexpr std::size_t BUCKETS = (OCTAVES + 1) * SUB_BUCKETS;
+
+  void record(std::uint64_t ns);
+
+  std::uint64_t count() const
+  {
+    return count_;
+  }
+
+  /**
+   * @brief The upper bound of the bucket of the q-quantile (q in [0, 1]), in ns
+   */
+  std::uint64_t percentile(double q) const;
+
+  /**
+   * @brief The bucket of a value, and the range [lower, upper] of the values of a bucket
+   */
+  static std::size_t bucket(std::uint64_t ns);
+  static std::uint64_t lower(std::size_t bucket);
+  static std::uint64_t upper(std::size_t bucket);
+
+  void merge(const LatencyHistogram& other);
+
+private:
+  std::array<std::uint64_t, BUCKETS> buckets_{};
+  std::uint64_t count_ = 0;
+};
+
+/**
+ * @brief The accesses to a path
+ */
+struct KeyAccess
+{
+  std::string path;
+  std::string type;  // the decoded type (empty for the plain lookups, as get_leaf)
+  std::uint64_t lookups = 0;
+  std::uint64_t total_ns = 0;
+  std::size_t threads = 0;  // number of distinct threads that accessed the path
+  LatencyHistogram latency;
+};
+
+/**
+ * @brief Opt-in recorder of the accesses to the configuration. When it is enabled, get_leaf (of the YAML::Node and
+ * of the FrozenNode, with dynamic or static keys) and Param<T>::load record, for each resolved path, the number of
+ * lookups, the decoded type, the threads and the latency. A call nested in another recorded call (e.g. the get_leaf
+ * of Param<T>::load) is not recorded again.
+ *
+ * When it is disabled (the default), the instrumented calls pay a relaxed load of a flag.
+ *
+ * @code
+ * cnr::yaml::enable_access_profiling(true);
+ * run_the_application();
+ * cnr::yaml::write_access_report(std::cout, 50);
+ * std::ofstream manifest("hot_keys.yaml");
+ * cnr::yaml::write_hot_keys(manifest, 200);  // to be pre-resolved at startup (see warmup)
+ * @endcode
+ */
+void enable_access_profiling(const bool& enable);
+
+/**
+ * @brief The recorded accesses, sorted by the total time (the most expensive first)
+ */
+std::vector<KeyAccess> access_report();
+
+void reset_access_profile();
+
+/**
+ * @brief A table of the accesses sorted by cost (max_rows = 0 prints all of them)
+ */
+void write_access_report(std::ostream& os, const std::size_t& max_rows = 0);
+
+/**
+ * @brief The most expensive paths, as a YAML sequence of {path, type} (the type is omitted for the plain lookups),
+ * that is the manifest read by warmup
+ */
+void write_hot_keys(std::ostream& os, const std::size_t& max_keys = 0);
+
+namespace detail
+{
+extern std::atomic<bool> access_profiling;
+
+/**
+ * @brief Nesting of the recorded calls of the thread
+ */
+inline thread_local unsigned int access_depth = 0;
+
+void record_access(std::string_view path, std::string_view type, std::uint64_t ns, std::string_view delimeters);
+
+/**
+ * @brief Measure a call, and record it if the profiling is enabled and the call is not nested in another one
+ */
+class AccessTimer
+{
+public:
+  AccessTimer() : active_(access_profiling.load(std::memory_order_relaxed))
+  {
+    if (active_)
+    {
+      outer_ = access_depth++ == 0;
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~AccessTimer()
+  {
+    if (active_)
+    {
+      access_depth--;
+    }
+  }
+
+  /**
+   * @brief True if the call will be recorded: the callers can skip the building of the path otherwise
+   */
+  bool recording() const
+  {
+    return active_ && outer_;
+  }
+
+  /**
+   * @brief Record a successful resolution (the failed ones are not recorded, so that the report and the hot keys
+   * hold only existing paths). The path is normalized as a KeyPath split with the delimeters used by the lookup
+   * ("robot.arm/q" is recorded as "/robot/arm/q").
+   */
+  void record(std::string_view path, std::string_view type = std::string_view(), std::string_view delimeters = "/.")
+  {
+    if (active_ && outer_)
+    {
+      const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+      record_access(path, type, static_cast<std::uint64_t>(ns.count()), delimeters);
+    }
+  }
+
+  AccessTimer(const AccessTimer&) = delete;
+  AccessTimer& operator=(const AccessTimer&) = delete;
+
+private:
+  bool active_;
+  bool outer_ = false;
+  std::chrono::steady_clock::time_point start_{};
+};
+}  // namespace detail
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__ACCESS_PROFILE__H
@@ -53,5 +53,6 @@ struct as_if<T, std::optional<T>>
 // ========================================
 
 #include <cnr_yaml/impl/cnr_yaml.hpp>
+#include <cnr_yaml/impl/extern_templates.hpp>
 
 #endif // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__PARAM_H
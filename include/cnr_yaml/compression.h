@@ -0,0 +1,78 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__COMPRESSION__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__COMPRESSION__H
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace cnr
+{
+namespace yaml
+{
+
+enum class Compression
+{
+  NONE,
+  GZIP,
+  BZIP2,
+  ZSTD
+};
+
+std::string to_string(const Compression& compression);
+
+/**
+ * @brief The compression of a file from its first bytes. NONE if the magic bytes are not recognized.
+ */
+Compression compression_from_magic(std::string_view head);
+
+/**
+ * @brief The compression of a file from its extension (.gz, .bz2, .zst). NONE for the other extensions.
+ */
+Compression compression_from_extension(const std::string& path);
+
+/**
+ * @brief The magic bytes, if recognized, and then the extension
+ */
+Compression detect_compression(const std::string& path, std::string_view head);
+
+/**
+ * @brief Same as above, peeking the first bytes of a seekable source. The source is rewound to its beginning.
+ */
+Compression detect_compression(const std::string& path, std::streambuf& source);
+
+/**
+ * @brief false if the library has been built without the decompressor (zstd requires Boost 1.70)
+ */
+bool is_supported(const Compression& compression);
+
+/**
+ * @brief A std::istream decompressing the source on the fly (Boost.Iostreams). Only a buffer of decompressed data
+ * is kept in memory, so that the parser reads the file without inflating it first.
+ *
+ * The errors of the decompressor (e.g. a truncated file) are thrown by the reads, as the badbit of the stream is in
+ * the exceptions mask: a corrupted file is never parsed as a shorter valid document.
+ */
+class DecompressingStream : public std::istream
+{
+public:
+  /**
+   * @param source: the compressed data. It is not owned, and it must outlive the stream.
+   * @param compression: NONE reads the source as it is
+   * @param buffer_size: bytes of the decompressed buffer
+   */
+  DecompressingStream(std::streambuf* source, const Compression& compression, std::size_t buffer_size = 64 * 1024);
+  ~DecompressingStream() override;
+  DecompressingStream(const DecompressingStream&) = delete;
+  DecompressingStream& operator=(const DecompressingStream&) = delete;
+
+private:
+  std::unique_ptr<std::streambuf> buffer_;
+};
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__COMPRESSION__H
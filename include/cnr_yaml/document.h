@@ -0,0 +1,73 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__DOCUMENT__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__DOCUMENT__H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+
+#include <cnr_yaml/frozen_node.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief A YAML document parsed directly from the events of the YAML::Parser into a frozen tree, without building
+ * the YAML::Node graph: there is no per-node allocation, the temporary storage is a monotonic arena, and the result
+ * is a single blob (destroying the document is one free).
+ *
+ * The lookup and the decoding are the ones of the FrozenNode (get_leaf, get, operator[], ...). The aliases are
+ * expanded, and the keys must be scalars. As YAML::Load, only the first document of the stream is parsed.
+ */
+class Document
+{
+public:
+  Document() = default;
+
+  /**
+   * @brief Parse a YAML stream
+   *
+   * @param input
+   * @param what
+   * @return true
+   * @return false if the stream is not a valid YAML, or if it cannot be frozen
+   */
+  bool parse(std::istream& input, std::string& what);
+
+  /**
+   * @brief Parse a YAML string
+   */
+  bool parse(const std::string& input, std::string& what);
+
+  /**
+   * @brief Parse a YAML file
+   */
+  bool parse_file(const std::string& path, std::string& what);
+
+  const FrozenNode& root() const
+  {
+    return root_;
+  }
+  FrozenNode operator[](std::string_view key) const
+  {
+    return root_[key];
+  }
+
+  /**
+   * @brief Bytes of the frozen blob
+   */
+  std::size_t memory_usage() const
+  {
+    return root_.memory_usage();
+  }
+
+private:
+  FrozenNode root_;
+};
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__DOCUMENT__H
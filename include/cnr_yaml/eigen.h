@@ -110,7 +110,7 @@ struct convert<Eigen::Matrix<_Scalar, _Rows, _Cols, _Options, _MaxRows, _MaxCols
     return ret;
   }
 
-  static bool decode(const Node& node, Mat const& rhs)
+  static bool decode(const Node& node, Mat& rhs)
   {
     if (!node.IsSequence())
     {
@@ -119,7 +119,7 @@ struct convert<Eigen::Matrix<_Scalar, _Rows, _Cols, _Options, _MaxRows, _MaxCols
 
     constexpr bool should_be_a_vector = (Mat::RowsAtCompileTime == 1 || Mat::ColsAtCompileTime == 1);
 
-    Mat& _rhs = const_cast<Mat&>(rhs);
+    Mat& _rhs = rhs;
     try
     {
       if constexpr (should_be_a_vector)
@@ -0,0 +1,432 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__FROZEN_NODE__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__FROZEN_NODE__H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <Eigen/Core>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/hash.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * The frozen representation is a single relocatable blob:
+ *
+ *   | Header | Entry[entries] | double[numbers] | uint32_t[indexes] | char[strings] |
+ *
+ * All the references are offsets inside the blob, so that it can be copied, written to a file or memory-mapped
+ * without any fix-up. The nodes are stored in breadth-first order, so that the children of a node are contiguous.
+ * The keys and the scalars are interned in the string pool, the numeric scalars are parsed once, the sequences of
+ * numbers (and the rectangular sequences of sequences of numbers) are flattened in the numeric pool, and each map
+ * has a lookup table of its children sorted by key hash.
+ */
+namespace frozen
+{
+constexpr char MAGIC[8] = { 'C', 'N', 'R', 'Y', 'A', 'M', 'L', '\0' };
+constexpr std::uint32_t VERSION = 1;
+
+enum Flags : std::uint8_t
+{
+  IS_BOOL = 1,
+  IS_INTEGER = 2,
+  IS_DOUBLE = 4,
+  BOOL_VALUE = 8,
+  NUMERIC_ARRAY = 16,
+  NUMERIC_MATRIX = 32,
+  FLOW_STYLE = 64
+};
+
+struct Header
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t entry_size;
+  std::uint64_t size;
+  std::uint64_t entries_offset;
+  std::uint64_t entries;
+  std::uint64_t numbers_offset;
+  std::uint64_t numbers;
+  std::uint64_t indexes_offset;
+  std::uint64_t indexes;
+  std::uint64_t strings_offset;
+  std::uint64_t strings_size;
+};
+
+struct Entry
+{
+  std::uint64_t key_hash;
+  std::int64_t as_integer;
+  double as_double;
+  std::uint32_t key;       // offset of the key in the string pool
+  std::uint32_t key_size;
+  std::uint32_t data;      // Scalar: offset of the value in the string pool; Sequence/Map: index of the first child
+  std::uint32_t size;      // Scalar: length of the value; Sequence/Map: number of children
+  std::uint32_t tag;       // offset of the tag in the string pool
+  std::uint32_t tag_size;
+  std::uint32_t table;     // Sequence: offset in the numeric pool; Map: offset of the lookup table in the index pool
+  std::uint32_t cols;      // Sequence: columns of the flattened numbers (1 for a vector)
+  std::uint8_t type;       // YAML::NodeType::value
+  std::uint8_t flags;
+  std::uint8_t padding[6];
+};
+static_assert(sizeof(Entry) == 64, "The frozen entry must be 64 bytes");
+
+/**
+ * @brief View over a frozen blob. The blob is kept alive by the 'owner'.
+ */
+class Image
+{
+public:
+  /**
+   * @brief Construct the view, and check the header consistency.
+   *
+   * @param owner: the object that owns the memory (a buffer, a memory-mapped file, ...)
+   * @param data: pointer to the blob, aligned to 8 bytes
+   * @param size: bytes of the blob
+   * @throw std::runtime_error if the blob is not a valid frozen tree
+   */
+  Image(std::shared_ptr<const void> owner, const void* data, std::size_t size);
+
+  const Header& header() const
+  {
+    return *header_;
+  }
+  const Entry* entries() const
+  {
+    return entries_;
+  }
+  const double* numbers() const
+  {
+    return numbers_;
+  }
+  const std::uint32_t* indexes() const
+  {
+    return indexes_;
+  }
+  std::string_view string(std::uint32_t offset, std::uint32_t size) const
+  {
+    return std::string_view(strings_ + offset, size);
+  }
+  const void* data() const
+  {
+    return header_;
+  }
+  std::size_t bytes() const
+  {
+    return size_;
+  }
+
+private:
+  std::shared_ptr<const void> owner_;
+  std::size_t size_;
+  const Header* header_;
+  const Entry* entries_;
+  const double* numbers_;
+  const std::uint32_t* indexes_;
+  const char* strings_;
+};
+
+/**
+ * @brief It collects a tree in depth-first order (as the YAML events arrive), and it lays it out in a frozen blob.
+ * Inside a map, the scalars are alternatively used as keys and values. All the temporary storage is taken from a
+ * monotonic arena, released at once by finish(): the only allocation that survives is the blob.
+ */
+class Builder
+{
+public:
+  Builder();
+
+  void null(std::string_view tag = "");
+  void scalar(std::string_view value, std::string_view tag = "");
+  void begin_sequence(std::string_view tag = "", bool flow = false);
+  void begin_map(std::string_view tag = "", bool flow = false);
+  void end();
+
+  /**
+   * @brief Mark with an anchor the last scalar or null, the last opened sequence or map, or the pending key
+   */
+  void anchor(std::uint64_t id);
+
+  /**
+   * @brief Append a copy of the anchored node. The frozen tree is a tree, so that the aliases are expanded.
+   * @throw std::runtime_error if the anchor is unknown, or if the anchored collection is not closed yet
+   */
+  void alias(std::uint64_t id);
+
+  /**
+   * @brief Append a YAML::Node (and all its children)
+   */
+  void add(const YAML::Node& node);
+
+  /**
+   * @brief Lay out the collected tree. The builder is left empty.
+   */
+  std::shared_ptr<const Image> finish();
+
+private:
+  struct Node
+  {
+    std::uint64_t key_hash = 0;
+    std::int64_t as_integer = 0;
+    double as_double = 0.0;
+    std::uint32_t key = 0;
+    std::uint32_t key_size = 0;
+    std::uint32_t value = 0;
+    std::uint32_t value_size = 0;
+    std::uint32_t tag = 0;
+    std::uint32_t tag_size = 0;
+    std::uint32_t parent = 0;
+    std::uint32_t end = 0;  // one past the last node of the subtree
+    std::uint8_t type = 0;
+    std::uint8_t flags = 0;
+  };
+
+  struct Anchor
+  {
+    bool is_key = false;
+    std::uint32_t node = 0;
+    std::uint32_t key = 0;
+    std::uint32_t key_size = 0;
+  };
+
+  std::uint32_t intern(std::string_view str);
+  Node& push(std::uint8_t type, std::string_view tag);
+  bool key_expected() const;
+  void set_key(std::uint32_t offset, std::uint32_t size);
+  void reset();
+
+  std::pmr::monotonic_buffer_resource arena_;
+  std::pmr::vector<Node> nodes_{ &arena_ };
+  std::pmr::vector<std::uint32_t> stack_{ &arena_ };
+  std::pmr::string strings_{ &arena_ };
+  std::pmr::unordered_multimap<std::uint64_t, std::pair<std::uint32_t, std::uint32_t>> interned_{ &arena_ };
+  std::pmr::unordered_map<std::uint64_t, Anchor> anchors_{ &arena_ };
+  bool last_is_key_ = false;
+  bool key_pending_ = false;
+  std::uint64_t pending_key_hash_ = 0;
+  std::uint32_t pending_key_ = 0;
+  std::uint32_t pending_key_size_ = 0;
+};
+
+/**
+ * @brief Check the consistency of all the entries (offsets and sizes inside the pools). It is O(n), and it touches
+ * the whole blob: the Image constructor checks only the header.
+ *
+ * @param image
+ * @param what
+ * @return true
+ * @return false
+ */
+bool validate(const Image& image, std::string& what);
+
+/**
+ * @brief Parse a scalar following the same rules of the YAML::convert<> of yaml-cpp. It returns the flags (IS_BOOL,
+ * IS_INTEGER, IS_DOUBLE, BOOL_VALUE) and it fills the numeric values.
+ */
+std::uint8_t parse_scalar(std::string_view value, std::int64_t& as_integer, double& as_double);
+
+}  // namespace frozen
+
+/**
+ * @brief Read-only, contiguous copy of a YAML tree. It is built once (from a YAML::Node), and then the lookup is a
+ * binary search over pre-hashed keys, the numeric scalars are already parsed, and the numeric sequences are
+ * already flattened. The copies are cheap (the blob is shared), and it is safe to read it from many threads.
+ */
+class FrozenNode
+{
+public:
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = FrozenNode;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = FrozenNode;
+
+    const_iterator() = default;
+    const_iterator(std::shared_ptr<const frozen::Image> image, const frozen::Entry* entry)
+      : image_(std::move(image)), entry_(entry)
+    {
+    }
+    FrozenNode operator*() const
+    {
+      return FrozenNode(image_, entry_);
+    }
+    const_iterator& operator++()
+    {
+      ++entry_;
+      return *this;
+    }
+    const_iterator operator++(int)
+    {
+      const_iterator ret = *this;
+      ++entry_;
+      return ret;
+    }
+    bool operator==(const const_iterator& rhs) const
+    {
+      return entry_ == rhs.entry_;
+    }
+    bool operator!=(const const_iterator& rhs) const
+    {
+      return entry_ != rhs.entry_;
+    }
+
+  private:
+    std::shared_ptr<const frozen::Image> image_;
+    const frozen::Entry* entry_ = nullptr;
+  };
+
+  FrozenNode() = default;
+  explicit FrozenNode(const YAML::Node& node);
+  explicit FrozenNode(std::shared_ptr<const frozen::Image> image);
+  FrozenNode(std::shared_ptr<const frozen::Image> image, const frozen::Entry* entry);
+
+  bool IsDefined() const
+  {
+    return entry_ != nullptr;
+  }
+  bool IsNull() const
+  {
+    return entry_ && entry_->type == YAML::NodeType::Null;
+  }
+  bool IsScalar() const
+  {
+    return entry_ && entry_->type == YAML::NodeType::Scalar;
+  }
+  bool IsSequence() const
+  {
+    return entry_ && entry_->type == YAML::NodeType::Sequence;
+  }
+  bool IsMap() const
+  {
+    return entry_ && entry_->type == YAML::NodeType::Map;
+  }
+  explicit operator bool() const
+  {
+    return IsDefined();
+  }
+  YAML::NodeType::value Type() const;
+
+  /**
+   * @brief Number of children of a sequence or of a map, 0 otherwise
+   */
+  std::size_t size() const;
+
+  std::string_view Scalar() const;
+  std::string_view Tag() const;
+
+  /**
+   * @brief The key of the node in the parent map (empty for the root and for the items of a sequence)
+   */
+  std::string_view key() const;
+
+  /**
+   * @brief Lookup of a child of a map. If the key is missing, an undefined node is returned.
+   */
+  FrozenNode operator[](std::string_view key) const;
+
+  /**
+   * @brief Same as above, but the hash of the key has been already computed (see cnr::yaml::fnv1a)
+   */
+  FrozenNode find(std::string_view key, std::uint64_t key_hash) const;
+
+  /**
+   * @brief Item of a sequence. If the index is out of range, an undefined node is returned.
+   */
+  FrozenNode operator[](std::size_t index) const;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  /**
+   * @brief Zero-copy view of the flattened numbers of a numeric sequence (row-major for a matrix). Empty otherwise.
+   */
+  std::span<const double> numbers() const;
+
+  /**
+   * @brief Deep copy back to a YAML::Node
+   */
+  YAML::Node to_node() const;
+
+  /**
+   * @brief Bytes of the frozen blob shared by all the nodes of the tree
+   */
+  std::size_t memory_usage() const;
+
+  const frozen::Entry* entry() const
+  {
+    return entry_;
+  }
+  const std::shared_ptr<const frozen::Image>& image() const
+  {
+    return image_;
+  }
+
+private:
+  std::shared_ptr<const frozen::Image> image_;
+  const frozen::Entry* entry_ = nullptr;
+};
+
+using RowMajorMatrixXd = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+/**
+ * @brief Zero-copy view of a numeric sequence. The map is empty if the node is not a numeric sequence.
+ */
+Eigen::Map<const Eigen::VectorXd> as_eigen_vector(const FrozenNode& node);
+
+/**
+ * @brief Zero-copy view of a numeric sequence of sequences. A numeric sequence is seen as a column.
+ * The map is empty if the node is not numeric.
+ */
+Eigen::Map<const RowMajorMatrixXd> as_eigen_matrix(const FrozenNode& node);
+
+/**
+ * @brief Get the leaf object, as the get_leaf for the YAML::Node
+ *
+ * @param node
+ * @param key
+ * @param leaf
+ * @param what
+ * @param delimeters
+ * @return true
+ * @return false
+ */
+bool get_leaf(const FrozenNode& node, const std::string& key, FrozenNode& leaf, std::string& what,
+              const std::string& delimeters = "/.");
+
+/**
+ * @brief Get the object stored in a FrozenNode. The scalars, the std::vector, the std::array and the Eigen matrices
+ * are decoded directly from the frozen blob, while the other types are decoded from a YAML::Node copy.
+ * A std::span<const double> is a zero-copy view of a numeric sequence.
+ *
+ * @tparam T
+ * @param node
+ * @param ret
+ * @param what
+ * @param implicit_cast_if_possible
+ * @return true
+ * @return false
+ */
+template <typename T>
+bool get(const FrozenNode& node, T& ret, std::string& what, const bool& implicit_cast_if_possible);
+
+}  // namespace yaml
+}  // namespace cnr
+
+#include <cnr_yaml/impl/frozen_node.hpp>
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__FROZEN_NODE__H
@@ -0,0 +1,104 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__GENERATOR__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__GENERATOR__H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <yaml-cpp/yaml.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief The shape of a synthetic tree (see generate_tree)
+ */
+struct GeneratorOptions
+{
+  std::uint64_t seed = 0;
+
+  /**
+   * @brief Number of keys of each map
+   */
+  std::size_t breadth = 8;
+
+  /**
+   * @brief Number of levels of maps. The children of the maps of the last level are scalars or sequences.
+   */
+  std::size_t depth = 4;
+
+  /**
+   * @brief Length of the keys. The keys of a map are unique, and a suffix is added in case of collision.
+   */
+  std::size_t key_length = 8;
+
+  /**
+   * @brief Relative weights of the kinds of the children of a map (they do not need to sum to one)
+   */
+  double scalar_weight = 0.6;
+  double sequence_weight = 0.2;
+  double map_weight = 0.2;
+
+  /**
+   * @brief The sequences are numeric arrays, whose size is drawn in [min_array_size, max_array_size]
+   */
+  std::size_t min_array_size = 3;
+  std::size_t max_array_size = 7;
+
+  /**
+   * @brief The generation stops when this number of nodes (see count_nodes) is reached. Zero means no limit. The
+   * tree is generated depth-first, so that the last keys of the upper maps are the ones that are cut.
+   */
+  std::size_t max_nodes = 0;
+};
+
+/**
+ * @brief The shape of a synthetic robot cell (see generate_robot_cell)
+ */
+struct RobotCellOptions
+{
+  std::uint64_t seed = 0;
+  std::size_t robots = 2;
+  std::size_t arms_per_robot = 2;
+  std::size_t joints = 6;
+  std::size_t controllers_per_arm = 3;
+  std::size_t sensors = 4;
+};
+
+/**
+ * @brief A random tree of maps, scalars (double, int, bool and strings) and numeric arrays. The tree depends only on
+ * the options: the same seed gives the same tree on any platform (the pseudo-random generator and the draws are
+ * implemented here, instead of the implementation-defined std distributions).
+ *
+ * @code
+ * cnr::yaml::GeneratorOptions options;
+ * options.seed = 42;
+ * options.breadth = 20;
+ * options.depth = 6;
+ * options.map_weight = 1.0;       // mostly maps, down to the last level
+ * options.max_nodes = 100000;
+ * YAML::Node config = cnr::yaml::generate_tree(options);
+ * @endcode
+ */
+YAML::Node generate_tree(const GeneratorOptions& options);
+
+/**
+ * @brief A configuration shaped as a robot cell: robots with arms, each with the joint names and limits, the
+ * kinematic parameters, the tool, and a set of controllers with their gains; and a list of sensors. The numbers are
+ * random (and deterministic for a given seed), and the keys are the same for any seed.
+ *
+ * The paths look like "cell/robots/robot_0/arms/arm_1/limits/velocity" and
+ * "cell/robots/robot_0/arms/arm_1/controllers/controller_2/gains/p".
+ */
+YAML::Node generate_robot_cell(const RobotCellOptions& options);
+
+/**
+ * @brief The number of nodes of a tree: the maps, the sequences and the scalars (the keys are not counted)
+ */
+std::size_t count_nodes(const YAML::Node& node);
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__GENERATOR__H
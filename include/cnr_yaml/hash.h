@@ -0,0 +1,44 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__HASH__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__HASH__H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief FNV-1a 64 bit hash. It is constexpr, so that the hash of the literal keys can be computed at compile time.
+ *
+ * @param str
+ * @return std::uint64_t
+ */
+constexpr std::uint64_t fnv1a(std::string_view str) noexcept
+{
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const char c : str)
+  {
+    hash ^= static_cast<std::uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+/**
+ * @brief XXH64 hash (same result of the reference implementation of xxHash). It is used for the content of the
+ * files, where it is much faster than fnv1a.
+ *
+ * @param data
+ * @param size
+ * @param seed
+ * @return std::uint64_t
+ */
+std::uint64_t xxh64(const void* data, std::size_t size, std::uint64_t seed = 0) noexcept;
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__HASH__H
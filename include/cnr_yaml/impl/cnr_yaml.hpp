@@ -11,6 +11,7 @@
 #include <cnr_yaml/type_traits.h>
 #include <cnr_yaml/eigen.h>
 #include <cnr_yaml/node_utils.h>
+#include <cnr_yaml/stats.h>
 
 // BUGFIX - recursive declrataion - raised in U24.04
 // #include <cnr_yaml/impl/param_sequence.hpp>    // moved at the file end. 
@@ -78,7 +79,7 @@ inline bool decode(const YAML::Node& node, T& ret, std::string& what, const bool
 
   if (!ok)
   {
-    what = "Error! Deconding the type '" + boost::typeindex::type_id_with_cvr<decltype(ret)>().pretty_name() +
+    what = "Error! Deconding the type '" + std::string(cnr::yaml::type_name<decltype(ret)>()) +
            "' from the node was not possible, neither using the available alternatives. Input Node:\n" +
            std::to_string(node);
   }
@@ -96,6 +97,7 @@ inline bool decode(const YAML::Node& node, T& ret, std::string& what, const bool
     {
       if constexpr (std::is_same<type, T>::value)
       {
+        CNR_YAML_STATS_ADD(DECODE_ALTERNATIVES, 1);
         return YAML::convert<type>::decode(node, ret);
       }
       else
@@ -105,7 +107,8 @@ inline bool decode(const YAML::Node& node, T& ret, std::string& what, const bool
     }
     else
     {
-      type _ret;
+      type _ret{};
+      CNR_YAML_STATS_ADD(DECODE_ALTERNATIVES, 1);
       if (!YAML::convert<type>::decode(node, _ret))
       {
         return decode<T, I + 1, N>(node, ret, what, implicit_cast_if_possible);
@@ -119,19 +122,22 @@ inline bool decode(const YAML::Node& node, T& ret, std::string& what, const bool
   }
   catch (const std::exception& e)
   {
+    CNR_YAML_STATS_ADD(DECODE_EXCEPTIONS, 1);
     what += std::string(e.what());
   }
   catch (...)
   {
-    what += "Unknown error in decoding a '" + boost::typeindex::type_id_with_cvr<decltype(ret)>().pretty_name() +
+    CNR_YAML_STATS_ADD(DECODE_EXCEPTIONS, 1);
+    what += "Unknown error in decoding a '" + std::string(cnr::yaml::type_name<decltype(ret)>()) +
             "' from node\n" + std::to_string(node) + "";
   }
   return decode<T, I + 1, N>(node, ret, what, implicit_cast_if_possible);
 }
 
 template <typename T>
-inline bool get(const YAML::Node& node, T& ret, std::string& what, const bool& implicit_cast_if_possible)
+bool get(const YAML::Node& node, T& ret, std::string& what, const bool& implicit_cast_if_possible)
 {
+  CNR_YAML_STATS_SCOPE(GET_CALLS, GET_NS);
   try
   {
     if (decode<T, 0, std::variant_size<typename decoding_type_variant_holder<T>::variant>::value>(
@@ -146,10 +152,11 @@ inline bool get(const YAML::Node& node, T& ret, std::string& what, const bool& i
   }
   catch (...)
   {
-    what = "Unknown error in decoding a '" + boost::typeindex::type_id_with_cvr<T>().pretty_name() +
+    what = "Unknown error in decoding a '" + std::string(cnr::yaml::type_name<T>()) +
            "' from node\n" + std::to_string(node) + "";
   }
 
+  CNR_YAML_STATS_ADD(WHAT_BYTES, what.size());
   return false;
 }
 
@@ -162,7 +169,7 @@ inline bool get(const YAML::Node& node, T& ret, std::string& what, const bool& i
 template <typename T, unsigned int I, unsigned int N, std::enable_if<(I == N), bool>::type* = nullptr>
 inline bool encode(const T&, YAML::Node&, std::string& what)
 {
-  what = "Error! Encoding the type '" + boost::typeindex::type_id_with_cvr<T>().pretty_name() +
+  what = "Error! Encoding the type '" + std::string(cnr::yaml::type_name<T>()) +
          "' from the node was not possible, neither using the available alternatives.";
   return false;
 }
@@ -175,32 +182,32 @@ inline bool encode(const T& value, YAML::Node& ret, std::string& what)
   using type = std::variant_alternative<I, variant>::type;
   type _value;
 
+  CNR_YAML_STATS_ADD(ENCODE_ALTERNATIVES, 1);
   try
   {
-    what = "Input Type: " + boost::typeindex::type_id_with_cvr<const T&>().pretty_name() +
-           ", variant type: " + boost::typeindex::type_id_with_cvr<type>().pretty_name();
     cast(std::move(_value), std::move(value));
     ret = YAML::convert<type>::encode(_value);
-    what += ", Return Object: " + std::to_string(ret);
-    what += ", Node Type: " + std::to_string(ret.Type());
     return true;  // encode<T, I+1, N>(value, ret, what);
   }
   catch (const std::exception& e)
   {
-    what = std::string(e.what()) + ", " + what;
+    CNR_YAML_STATS_ADD(ENCODE_EXCEPTIONS, 1);
+    what = std::string(e.what()) + ", Input Type: " + std::string(cnr::yaml::type_name<const T&>()) +
+           ", variant type: " + std::string(cnr::yaml::type_name<type>());
   }
   catch (...)
   {
-    what = "Unknown error. " + what;
+    CNR_YAML_STATS_ADD(ENCODE_EXCEPTIONS, 1);
+    what = "Unknown error. Input Type: " + std::string(cnr::yaml::type_name<const T&>()) +
+           ", variant type: " + std::string(cnr::yaml::type_name<type>());
   }
   return encode<T, I + 1, N>(value, ret, what);
 }
 
 template <typename T>
-inline bool set(const T& value, YAML::Node& ret, std::string& what)
+bool set(const T& value, YAML::Node& ret, std::string& what)
 {
-  std::string err = "Error! Implicit Cast not used. Failed in encoding a '" +
-                    boost::typeindex::type_id_with_cvr<T>().pretty_name() + "'";
+  CNR_YAML_STATS_SCOPE(SET_CALLS, SET_NS);
   try
   {
     if (encode<T, 0, std::variant_size<typename encoding_type_variant_holder<T>::variant>::value>(value, ret, what))
@@ -210,12 +217,14 @@ inline bool set(const T& value, YAML::Node& ret, std::string& what)
   }
   catch (const std::exception& e)
   {
-    what = err + " What: " + std::string(e.what());
+    what = "Error! Implicit Cast not used. Failed in encoding a '" + std::string(cnr::yaml::type_name<T>()) +
+           "' What: " + std::string(e.what());
   }
   catch (...)
   {
-    what = err + " Unknown error in encoding a '" + boost::typeindex::type_id_with_cvr<T>().pretty_name() + "'";
+    what = "Error! Implicit Cast not used. Unknown error in encoding a '" + std::string(cnr::yaml::type_name<T>()) + "'";
   }
+  CNR_YAML_STATS_ADD(WHAT_BYTES, what.size());
   return false;
 }
 
@@ -332,7 +341,7 @@ inline bool get_map(const YAML::Node& node, T&, std::string& what, const bool&)
   std::stringstream _node;
   _node << node;
   what = "The type ' "
-        + boost::typeindex::type_id_with_cvr<decltype(T())>().pretty_name() 
+        + std::string(cnr::yaml::type_name<decltype(T())>()) 
           + "' is not supported. You must specilized your own 'get_map' template function\n Input Node: " + _node.str();
   return false;
 }
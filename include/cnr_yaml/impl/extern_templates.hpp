@@ -0,0 +1,96 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__EXTERN_TEMPLATES__HPP
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__EXTERN_TEMPLATES__HPP
+
+#include <string>
+#include <vector>
+#include <variant>
+#include <Eigen/Core>
+#include <yaml-cpp/yaml.h>
+#include <cnr_yaml/type_traits.h>
+
+namespace cnr
+{
+namespace yaml
+{
+namespace instantiation
+{
+using Vector6d = Eigen::Matrix<double, 6, 1>;
+using Vector7d = Eigen::Matrix<double, 7, 1>;
+}  // namespace instantiation
+}  // namespace yaml
+}  // namespace cnr
+
+/**
+ * @brief The types whose get and set are instantiated once, in libcnr_yaml.so. The numeric types (int, double, their
+ * std::vector and the Eigen matrices, that are decoded through std::vector<double>) are not in the list: their
+ * decoding depends on decoding_type_variant_holder<int> and <double>, that the users specialize to enable the
+ * implicit cast, and a copy compiled in the library would ignore the specializations.
+ */
+#define CNR_YAML_COMMON_TYPES(X)                                                                                       \
+  X(bool)                                                                                                              \
+  X(std::string)                                                                                                       \
+  X(std::vector<bool>)                                                                                                 \
+  X(std::vector<std::string>)
+
+/**
+ * @brief The numeric types, instantiated in the library only if it is built with the EXTERN_NUMERIC_TEMPLATES option
+ * (that defines CNR_YAML_EXTERN_NUMERIC_TEMPLATES for the library and for its users). It is meant for the programs
+ * that do not specialize decoding_type_variant_holder<int> and <double>: the option declares them below.
+ */
+#define CNR_YAML_NUMERIC_TYPES(X)                                                                                      \
+  X(int)                                                                                                               \
+  X(double)                                                                                                            \
+  X(std::vector<int>)                                                                                                  \
+  X(std::vector<double>)                                                                                               \
+  X(Eigen::VectorXd)                                                                                                   \
+  X(Eigen::MatrixXd)                                                                                                   \
+  X(Eigen::Vector3d)                                                                                                   \
+  X(cnr::yaml::instantiation::Vector6d)                                                                                \
+  X(cnr::yaml::instantiation::Vector7d)
+
+#ifdef CNR_YAML_EXTERN_NUMERIC_TEMPLATES
+namespace cnr
+{
+namespace yaml
+{
+/**
+ * @brief The holders compiled in the numeric instantiations of the library. They are declared here, so that a
+ * program that specializes them again gets a redefinition error instead of the copy of the library silently ignoring
+ * its specializations. Such a program builds the library without EXTERN_NUMERIC_TEMPLATES.
+ */
+template <>
+struct decoding_type_variant_holder<int>
+{
+  using base = int;
+  using variant = std::variant<int>;
+};
+
+template <>
+struct decoding_type_variant_holder<double>
+{
+  using base = double;
+  using variant = std::variant<double>;
+};
+}  // namespace yaml
+}  // namespace cnr
+#endif
+
+#define CNR_YAML_INSTANTIATE(PREFIX, T)                                                                                \
+  PREFIX template bool cnr::yaml::get<T>(const YAML::Node& node, T& ret, std::string& what,                            \
+                                         const bool& implicit_cast_if_possible);                                       \
+  PREFIX template bool cnr::yaml::set<T>(const T& value, YAML::Node& ret, std::string& what);
+
+/**
+ * @brief The extern declarations can be disabled by defining CNR_YAML_NO_EXTERN_TEMPLATES before including cnr_yaml.h
+ * (e.g. to check that a translation unit compiles all its instantiations)
+ */
+#ifndef CNR_YAML_NO_EXTERN_TEMPLATES
+#define CNR_YAML_EXTERN_TEMPLATE(T) CNR_YAML_INSTANTIATE(extern, T)
+CNR_YAML_COMMON_TYPES(CNR_YAML_EXTERN_TEMPLATE)
+#ifdef CNR_YAML_EXTERN_NUMERIC_TEMPLATES
+CNR_YAML_NUMERIC_TYPES(CNR_YAML_EXTERN_TEMPLATE)
+#endif
+#undef CNR_YAML_EXTERN_TEMPLATE
+#endif
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__EXTERN_TEMPLATES__HPP
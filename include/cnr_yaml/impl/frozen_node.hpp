@@ -0,0 +1,314 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__FROZEN_NODE__HPP
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__FROZEN_NODE__HPP
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <variant>
+#include <Eigen/Core>
+#include <cnr_yaml/type_name.h>
+
+#include <cnr_yaml/cnr_yaml.h>
+#include <cnr_yaml/frozen_node.h>
+
+namespace cnr
+{
+namespace yaml
+{
+namespace frozen
+{
+
+template <typename T>
+struct is_std_array : std::false_type
+{
+};
+
+template <typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type
+{
+};
+
+template <typename V>
+struct has_floating_alternative : std::false_type
+{
+};
+
+template <typename... Ts>
+struct has_floating_alternative<std::variant<Ts...>>
+  : std::integral_constant<bool, (std::is_floating_point<Ts>::value || ...)>
+{
+};
+
+template <typename T>
+inline bool in_range(const std::int64_t& v)
+{
+  if constexpr (std::is_unsigned<T>::value)
+  {
+    return v >= 0 && static_cast<std::uint64_t>(v) <= static_cast<std::uint64_t>(std::numeric_limits<T>::max());
+  }
+  else
+  {
+    return v >= static_cast<std::int64_t>(std::numeric_limits<T>::min()) &&
+           v <= static_cast<std::int64_t>(std::numeric_limits<T>::max());
+  }
+}
+
+template <typename T>
+inline bool decode_failure(const FrozenNode& node, std::string& what, const std::string& reason)
+{
+  what = "Error! Decoding the type '" + std::string(cnr::yaml::type_name<T>()) +
+         "' from the frozen node was not possible: " + reason + ". Input Node:\n" + std::to_string(node.to_node());
+  return false;
+}
+
+template <typename T>
+bool decode(const FrozenNode& node, T& ret, std::string& what, const bool& implicit_cast_if_possible);
+
+template <typename T>
+inline bool decode_integer(const FrozenNode& node, T& ret, std::string& what, const bool& implicit_cast_if_possible)
+{
+  if (!node.IsScalar())
+  {
+    return decode_failure<T>(node, what, "the node is not a scalar");
+  }
+  const Entry* e = node.entry();
+  if (e->flags & IS_INTEGER)
+  {
+    if (!in_range<T>(e->as_integer))
+    {
+      return decode_failure<T>(node, what, "the value is out of range");
+    }
+    ret = static_cast<T>(e->as_integer);
+    return true;
+  }
+
+  // the implicit cast from a floating point is allowed only if the decoding alternatives of T have a floating type
+  using variant = typename decoding_type_variant_holder<T>::variant;
+  if (implicit_cast_if_possible && has_floating_alternative<variant>::value && (e->flags & IS_DOUBLE))
+  {
+    // the bounds are powers of two, exact as doubles: max() would round up to the (excluded) 2^digits for 64 bits
+    constexpr int digits = std::numeric_limits<T>::digits;
+    const double lower = std::is_signed<T>::value ? -std::ldexp(1.0, digits) : 0.0;
+    const double upper = std::ldexp(1.0, digits);
+    if (!(e->as_double >= lower && e->as_double < upper))
+    {
+      return decode_failure<T>(node, what, "the value is out of range");
+    }
+    ret = static_cast<T>(e->as_double);
+    return true;
+  }
+  return decode_failure<T>(node, what, "the scalar is not an integer");
+}
+
+template <typename T, typename A>
+inline bool decode_vector(const FrozenNode& node, std::vector<T, A>& ret, std::string& what,
+                          const bool& implicit_cast_if_possible)
+{
+  if (!node.IsSequence())
+  {
+    return decode_failure<std::vector<T, A>>(node, what, "the node is not a sequence");
+  }
+  const Entry* e = node.entry();
+  if constexpr (std::is_floating_point<T>::value)
+  {
+    if (e->flags & NUMERIC_ARRAY)
+    {
+      const double* begin = node.image()->numbers() + e->table;
+      ret.assign(begin, begin + e->size);
+      return true;
+    }
+  }
+
+  ret.clear();
+  ret.reserve(e->size);
+  std::size_t i = 0;
+  for (const auto& item : node)
+  {
+    T v = T();
+    if (!decode(item, v, what, implicit_cast_if_possible))
+    {
+      what = "Error in the extraction of the element #" + std::to_string(i) + ": " + what;
+      return false;
+    }
+    ret.push_back(std::move(v));
+    i++;
+  }
+  return true;
+}
+
+template <typename T, std::size_t N>
+inline bool decode_array(const FrozenNode& node, std::array<T, N>& ret, std::string& what,
+                         const bool& implicit_cast_if_possible)
+{
+  if (!node.IsSequence())
+  {
+    return decode_failure<std::array<T, N>>(node, what, "the node is not a sequence");
+  }
+  if (node.size() != N)
+  {
+    return decode_failure<std::array<T, N>>(node, what,
+                                            "the sequence has " + std::to_string(node.size()) + " elements");
+  }
+  std::size_t i = 0;
+  for (const auto& item : node)
+  {
+    if (!decode(item, ret[i], what, implicit_cast_if_possible))
+    {
+      what = "Error in the extraction of the element #" + std::to_string(i) + ": " + what;
+      return false;
+    }
+    i++;
+  }
+  return true;
+}
+
+template <typename Derived>
+inline bool decode_eigen(const FrozenNode& node, Eigen::MatrixBase<Derived>& ret, std::string& what)
+{
+  using Scalar = typename Derived::Scalar;
+  using RowMajor = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  constexpr int expected_rows = Derived::RowsAtCompileTime;
+  constexpr int expected_cols = Derived::ColsAtCompileTime;
+  constexpr bool should_be_a_vector = (expected_rows == 1 || expected_cols == 1);
+
+  if (!node.IsSequence())
+  {
+    return decode_failure<Derived>(node, what, "the node is not a sequence");
+  }
+  const Entry* e = node.entry();
+  const double* data = node.image()->numbers() + e->table;
+  int rows = 0;
+  int cols = 0;
+  if (e->flags & NUMERIC_ARRAY)
+  {
+    // as in the YAML::convert<>, a flat sequence is a column, unless a row-vector is expected
+    int dim = static_cast<int>(e->size);
+    rows = expected_rows == 1 ? 1 : dim;
+    cols = expected_rows == 1 ? dim : 1;
+  }
+  else if (!should_be_a_vector && (e->flags & NUMERIC_MATRIX))
+  {
+    rows = static_cast<int>(e->size);
+    cols = static_cast<int>(e->cols);
+  }
+  else
+  {
+    return decode_failure<Derived>(node, what, "the node is not a numeric vector or matrix");
+  }
+
+  if (!resize(ret, rows, cols))
+  {
+    return decode_failure<Derived>(node, what,
+                                   "it was expected a (" + std::to_string(expected_rows) + "x" +
+                                       std::to_string(expected_cols) + ") matrix while the param store a (" +
+                                       std::to_string(rows) + "x" + std::to_string(cols) + ") matrix");
+  }
+  ret.derived() = Eigen::Map<const RowMajor>(data, rows, cols).template cast<Scalar>();
+  return true;
+}
+
+template <typename T>
+inline bool decode(const FrozenNode& node, T& ret, std::string& what, const bool& implicit_cast_if_possible)
+{
+  if (!node.IsDefined())
+  {
+    what = "Error! Decoding the type '" + std::string(cnr::yaml::type_name<T>()) +
+           "' from an undefined frozen node";
+    return false;
+  }
+
+  if constexpr (std::is_same<T, std::string>::value)
+  {
+    if (!node.IsScalar())
+    {
+      return decode_failure<T>(node, what, "the node is not a scalar");
+    }
+    ret.assign(node.Scalar());
+    return true;
+  }
+  else if constexpr (std::is_same<T, bool>::value)
+  {
+    if (!node.IsScalar() || !(node.entry()->flags & IS_BOOL))
+    {
+      return decode_failure<T>(node, what, "the node is not a boolean");
+    }
+    ret = (node.entry()->flags & BOOL_VALUE) != 0;
+    return true;
+  }
+  else if constexpr (std::is_integral<T>::value && !std::is_same<T, char>::value)
+  {
+    return decode_integer(node, ret, what, implicit_cast_if_possible);
+  }
+  else if constexpr (std::is_floating_point<T>::value)
+  {
+    if (!node.IsScalar() || !(node.entry()->flags & IS_DOUBLE))
+    {
+      return decode_failure<T>(node, what, "the node is not a floating point");
+    }
+    ret = static_cast<T>(node.entry()->as_double);
+    return true;
+  }
+  else if constexpr (is_std_vector<T>::value)
+  {
+    return decode_vector(node, ret, what, implicit_cast_if_possible);
+  }
+  else if constexpr (is_std_array<T>::value)
+  {
+    return decode_array(node, ret, what, implicit_cast_if_possible);
+  }
+  else if constexpr (is_eigen_matrix<T>::value)
+  {
+    return decode_eigen(node, ret, what);
+  }
+  else if constexpr (std::is_same<T, std::span<const double>>::value)
+  {
+    if (!node.IsSequence() || (node.size() && !(node.entry()->flags & (NUMERIC_ARRAY | NUMERIC_MATRIX))))
+    {
+      return decode_failure<T>(node, what, "the node is not a numeric sequence");
+    }
+    ret = node.numbers();
+    return true;
+  }
+  else if constexpr (std::is_same<T, FrozenNode>::value)
+  {
+    ret = node;
+    return true;
+  }
+  else if constexpr (std::is_same<T, YAML::Node>::value)
+  {
+    ret = node.to_node();
+    return true;
+  }
+  else
+  {
+    // user-defined types: fallback to the YAML::convert<> on a YAML::Node copy
+    return cnr::yaml::get(node.to_node(), ret, what, implicit_cast_if_possible);
+  }
+}
+
+}  // namespace frozen
+
+template <typename T>
+inline bool get(const FrozenNode& node, T& ret, std::string& what, const bool& implicit_cast_if_possible)
+{
+  try
+  {
+    return frozen::decode(node, ret, what, implicit_cast_if_possible);
+  }
+  catch (const std::exception& e)
+  {
+    what = std::string(e.what());
+  }
+  catch (...)
+  {
+    what = "Unknown error in decoding a '" + std::string(cnr::yaml::type_name<T>()) +
+           "' from a frozen node";
+  }
+  return false;
+}
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__FROZEN_NODE__HPP
@@ -3,7 +3,7 @@
 
 #include <iomanip>
 #include <string>
-#include <boost/type_index.hpp>
+#include <cnr_yaml/type_name.h>
 #include <yaml-cpp/yaml.h>
 #include <sstream>
 
@@ -20,7 +20,7 @@
   {\
       std::cerr << __PRETTY_FUNCTION__ << ":" << __LINE__ << ": "\
         << "YAML Exception, Error in the extraction of an object of type '"\
-          << boost::typeindex::type_id_with_cvr<decltype( X )>().pretty_name() \
+          << cnr::yaml::type_name<decltype( X )>() \
             << "'" << std::endl\
               << "Node: " << std::endl\
                 << node << std::endl\
@@ -31,7 +31,7 @@
     {\
       std::cerr << __PRETTY_FUNCTION__ << ":" << __LINE__ << ": "\
         << "Exception, Error in the extraction of an object of type '"\
-          << boost::typeindex::type_id_with_cvr<decltype( X )>().pretty_name() \
+          << cnr::yaml::type_name<decltype( X )>() \
             << "'" << std::endl\
               << "Node: " << std::endl\
                 << node << std::endl\
@@ -1,7 +1,7 @@
 #ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__UTILS__IMPL__PARAM_MAP__HPP
 #define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__UTILS__IMPL__PARAM_MAP__HPP
 
-#include <boost/type_index.hpp>
+#include <cnr_yaml/type_name.h>
 #include <yaml-cpp/yaml.h>
 
 #include <cnr_yaml/string.h>
@@ -25,7 +25,7 @@ inline bool get_map(const YAML::Node& node, T&, std::string& what, const bool&)
   std::stringstream _node;
   _node << node;
   what = "The type ' "
-        + boost::typeindex::type_id_with_cvr<decltype(T())>().pretty_name() 
+        + std::string(cnr::yaml::type_name<decltype(T())>()) 
           + "' is not supported. You must specilized your own 'get_map' template function\n Input Node: " + _node.str();
   return false;
 }
@@ -1,7 +1,7 @@
 #ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__UTILS__IMPL__PARAM_SEQUENCE__HPP
 #define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__UTILS__IMPL__PARAM_SEQUENCE__HPP
 
-#include <boost/type_index.hpp>
+#include <cnr_yaml/type_name.h>
 #include <yaml-cpp/yaml.h>
 #include <Eigen/Core>
 
@@ -24,7 +24,7 @@
   {                                                                                                                    \
     std::cerr << __PRETTY_FUNCTION__ << ":" << __LINE__ << ": "                                                        \
               << "YAML Exception, Error in the extraction of an object of type '"                                      \
-              << boost::typeindex::type_id_with_cvr<decltype(X)>().pretty_name() << "'" << std::endl                   \
+              << cnr::yaml::type_name<decltype(X)>() << "'" << std::endl                   \
               << "Node: " << std::endl                                                                                 \
               << node << std::endl                                                                                     \
               << "What: " << std::endl                                                                                 \
@@ -34,7 +34,7 @@
   {                                                                                                                    \
     std::cerr << __PRETTY_FUNCTION__ << ":" << __LINE__ << ": "                                                        \
               << "Exception, Error in the extraction of an object of type '"                                           \
-              << boost::typeindex::type_id_with_cvr<decltype(X)>().pretty_name() << "'" << std::endl                   \
+              << cnr::yaml::type_name<decltype(X)>() << "'" << std::endl                   \
               << "Node: " << std::endl                                                                                 \
               << node << std::endl                                                                                     \
               << "What: " << std::endl                                                                                 \
@@ -82,7 +82,7 @@ inline bool _get_sequence(const YAML::Node& node, std::vector<T, A>& ret, std::s
 {
   if (!node.IsSequence())
   {
-    what = "Tried to extract a '" + boost::typeindex::type_id_with_cvr<decltype(T())>().pretty_name() +
+    what = "Tried to extract a '" + std::string(cnr::yaml::type_name<decltype(T())>()) +
            "' but the node is " + std::to_string(node.Type()) +
            "\n>> Input Node:\n" + std::to_string(node);
 
@@ -119,7 +119,7 @@ inline bool _get_sequence(const YAML::Node& node, std::vector<std::vector<T, A>>
   {
     std::stringstream _node;
     _node << node;
-    what = "Tried to extract a '" + boost::typeindex::type_id_with_cvr<decltype(T())>().pretty_name() +
+    what = "Tried to extract a '" + std::string(cnr::yaml::type_name<decltype(T())>()) +
            "' but the node is " + std::to_string(config.Type()) + "\n Input Node:\n" + _node.str();
   }
   else
@@ -133,7 +133,7 @@ inline bool _get_sequence(const YAML::Node& node, std::vector<std::vector<T, A>>
         {
           std::stringstream _node;
           _node << config;
-          what = "Tried to extract a '" + boost::typeindex::type_id_with_cvr<decltype(T())>().pretty_name() +
+          what = "Tried to extract a '" + std::string(cnr::yaml::type_name<decltype(T())>()) +
                   "' but the node is " + std::to_string(config.Type()) + "\n Input Node:\n" + _node.str();
         }
         std::vector<T> v;
@@ -143,7 +143,7 @@ inline bool _get_sequence(const YAML::Node& node, std::vector<std::vector<T, A>>
           std::stringstream _node;
           _node << node;
           what = "Error in the extraction of the element #" + std::to_string(i)
-                 + ". Type of the sequence: " + boost::typeindex::type_id_with_cvr<decltype(T())>().pretty_name() +
+                 + ". Type of the sequence: " + std::string(cnr::yaml::type_name<decltype(T())>()) +
                     "' but the node is " + std::to_string(config.Type()) + "\n Input Node:\n" + _node.str();
           break;
         }
@@ -167,7 +167,7 @@ inline bool _get_sequence(const YAML::Node& node, std::array<T, N>& ret, std::st
     {
       std::stringstream _node;
       _node << node;
-      what = "Tried to extract a '" + boost::typeindex::type_id_with_cvr<decltype(T())>().pretty_name() +
+      what = "Tried to extract a '" + std::string(cnr::yaml::type_name<decltype(T())>()) +
              "'  but there is a size mismathc between the expected and the got one.\n Input Node:\n" + _node.str();
       ok = false;
     }
@@ -193,7 +193,7 @@ inline bool _get_sequence(const YAML::Node& node, std::array<std::array<T, M>, N
     {
       std::stringstream _node;
       _node << node;
-      what = "Tried to extract a '" + boost::typeindex::type_id_with_cvr<decltype(T())>().pretty_name() +
+      what = "Tried to extract a '" + std::string(cnr::yaml::type_name<decltype(T())>()) +
              "' ?error in size? \n Input Node:\n" + _node.str();
       ok = false;
     }
@@ -296,7 +296,7 @@ inline bool _get_sequence(const YAML::Node& node, T& ret, std::string& what, con
 
   std::stringstream _node;
   _node << node;
-  what = "The type ' " + boost::typeindex::type_id_with_cvr<decltype(T())>().pretty_name() +
+  what = "The type ' " + std::string(cnr::yaml::type_name<decltype(T())>()) +
          "' is not supported. You must specilized your own 'get_sequence' template function\n Input Node: " + _node.str();
 
   return false;
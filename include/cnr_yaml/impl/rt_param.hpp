@@ -0,0 +1,82 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__RT_PARAM__HPP
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__RT_PARAM__HPP
+
+#include <cnr_yaml/access_profile.h>
+#include <cnr_yaml/cnr_yaml.h>
+#include <cnr_yaml/node_utils.h>
+#include <cnr_yaml/rt_param.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+template <typename T>
+inline Param<T>::Param(const KeyPath& key) : key_(key)
+{
+}
+
+template <typename T>
+inline bool Param<T>::load(const YAML::Node& config, std::string& what, const bool& implicit_cast_if_possible)
+{
+  detail::AccessTimer timer;
+  YAML::Node leaf;
+  T value{};
+  const bool ok =
+      get_leaf(config, key_.str().substr(1), leaf, what, "/") && cnr::yaml::get(leaf, value, what, implicit_cast_if_possible);
+  if (!ok)
+  {
+    what = "Param '" + key_.str() + "': " + what;
+    return false;
+  }
+  if (timer.recording())
+  {
+    timer.record(key_.str(), type_name<T>(), "/");
+  }
+  set(value);
+  return true;
+}
+
+template <typename T>
+inline bool Param<T>::load(const FrozenNode& config, std::string& what, const bool& implicit_cast_if_possible)
+{
+  detail::AccessTimer timer;
+  FrozenNode leaf;
+  T value{};
+  const bool ok =
+      get_leaf(config, key_.str().substr(1), leaf, what, "/") && cnr::yaml::get(leaf, value, what, implicit_cast_if_possible);
+  if (!ok)
+  {
+    what = "Param '" + key_.str() + "': " + what;
+    return false;
+  }
+  if (timer.recording())
+  {
+    timer.record(key_.str(), type_name<T>(), "/");
+  }
+  set(value);
+  return true;
+}
+
+template <typename T>
+inline void Param<T>::set(const T& value)
+{
+  std::lock_guard<std::mutex> lock(writer_mtx_);
+  slots_[back_] = value;
+  back_ = middle_.exchange(back_ | DIRTY, std::memory_order_acq_rel) & INDEX;
+}
+
+template <typename T>
+inline const T& Param<T>::get() noexcept
+{
+  if (middle_.load(std::memory_order_relaxed) & DIRTY)
+  {
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+  }
+  return slots_[front_];
+}
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__RT_PARAM__HPP
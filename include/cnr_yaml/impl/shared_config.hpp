@@ -0,0 +1,48 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__SHARED_CONFIG__HPP
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__SHARED_CONFIG__HPP
+
+#include <cnr_yaml/cnr_yaml.h>
+#include <cnr_yaml/shared_config.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+template <typename T>
+inline bool SharedConfig::Batch::set(const KeyPath& key, const T& value, std::string& what)
+{
+  YAML::Node node;
+  if (!cnr::yaml::set(value, node, what))
+  {
+    return false;
+  }
+  set_leaf(key, node);
+  return true;
+}
+
+template <typename T>
+inline std::uint64_t SharedConfig::set(const KeyPath& key, const T& value, std::string& what)
+{
+  Batch batch(*this);
+  return batch.set(key, value, what) ? batch.commit(what) : 0;
+}
+
+template <typename T>
+inline std::size_t SharedConfig::subscribe(const KeyPath& prefix,
+                                           const std::function<void(const T& value, const Notification&)>& callback)
+{
+  return subscribe(prefix, Callback([callback](const Notification& notification) {
+                     T value{};
+                     std::string what;
+                     if (cnr::yaml::get(notification.value, value, what, true))
+                     {
+                       callback(value, notification);
+                     }
+                   }));
+}
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__SHARED_CONFIG__HPP
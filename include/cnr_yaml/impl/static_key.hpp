@@ -0,0 +1,88 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__STATIC_KEY__HPP
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__STATIC_KEY__HPP
+
+#include <cnr_yaml/access_profile.h>
+#include <cnr_yaml/static_key.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+template <fixed_string Path>
+inline FrozenNode find(const FrozenNode& node, StaticKey<Path>)
+{
+  using Key = StaticKey<Path>;
+  FrozenNode ret = node;
+  for (std::size_t i = 0; i < Key::size && ret; i++)
+  {
+    ret = ret.find(Key::token(i), Key::tokens[i].hash);
+  }
+  return ret;
+}
+
+template <fixed_string Path>
+inline bool get_leaf(const FrozenNode& node, StaticKey<Path>, FrozenNode& leaf, std::string& what)
+{
+  using Key = StaticKey<Path>;
+  detail::AccessTimer timer;
+  if (!node)
+  {
+    what = "The key '" + std::string(Key::path) + "' cannot be resolved in an undefined frozen node";
+    return false;
+  }
+  FrozenNode ret = node;
+  for (std::size_t i = 0; i < Key::size; i++)
+  {
+    FrozenNode child = ret.find(Key::token(i), Key::tokens[i].hash);
+    if (!child)
+    {
+      what = "The key '" + std::string(Key::path) + "' has been resolved in the token '" + std::string(Key::token(i)) +
+             "' that is not in the node dictionary (Input Node: " + std::to_string(ret.to_node()) + ")";
+      return false;
+    }
+    ret = child;
+  }
+  leaf = ret;
+  timer.record(Key::path);
+  return true;
+}
+
+template <fixed_string Path>
+inline bool get_leaf(const YAML::Node& node, StaticKey<Path>, YAML::Node& leaf, std::string& what)
+{
+  using Key = StaticKey<Path>;
+  detail::AccessTimer timer;
+  YAML::Node ret(node);
+  for (std::size_t i = 0; i < Key::size; i++)
+  {
+    const std::string_view token = Key::token(i);
+    bool found = false;
+    if (ret.IsMap())
+    {
+      for (const auto& child : ret)
+      {
+        if (child.first.IsScalar() && child.first.Scalar() == token)
+        {
+          ret.reset(child.second);
+          found = true;
+          break;
+        }
+      }
+    }
+    if (!found)
+    {
+      what = "The key '" + std::string(Key::path) + "' has been resolved in the token '" + std::string(token) +
+             "' that is not in the node dictionary (Input Node: " + std::to_string(ret) + ")";
+      return false;
+    }
+  }
+  leaf.reset(ret);
+  timer.record(Key::path);
+  return true;
+}
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__STATIC_KEY__HPP
@@ -0,0 +1,102 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__WARMUP__HPP
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__WARMUP__HPP
+
+#include <algorithm>
+
+#include <cnr_yaml/warmup.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+template <typename T>
+inline void register_warmup_type(const std::vector<std::string>& aliases)
+{
+  const WarmupDecoder decoder = [](const FrozenNode& node, std::any& value, std::string& what) {
+    T ret{};
+    if (!cnr::yaml::get(node, ret, what, true))
+    {
+      return false;
+    }
+    value = std::move(ret);
+    return true;
+  };
+  register_warmup_decoder(std::string(type_name<T>()), decoder);
+  for (const auto& alias : aliases)
+  {
+    register_warmup_decoder(alias, decoder);
+  }
+}
+
+inline void register_numeric_warmup_types()
+{
+  register_warmup_type<double>({ "double" });
+  register_warmup_type<int>({ "int" });
+  register_warmup_type<std::vector<double>>({ "std::vector<double>" });
+  register_warmup_type<std::vector<int>>({ "std::vector<int>" });
+  register_warmup_type<Eigen::VectorXd>({ "Eigen::VectorXd" });
+  register_warmup_type<Eigen::MatrixXd>({ "Eigen::MatrixXd" });
+  register_warmup_type<Eigen::Vector3d>({ "Eigen::Vector3d" });
+  register_warmup_type<instantiation::Vector6d>({ "Eigen::Vector6d" });
+  register_warmup_type<instantiation::Vector7d>({ "Eigen::Vector7d" });
+}
+
+template <fixed_string Path>
+inline int WarmCache::PathLess::compare(const KeyPath& a, StaticKey<Path>)
+{
+  using Key = StaticKey<Path>;
+  for (std::size_t i = 0; i < a.size() && i < Key::size; i++)
+  {
+    if (const int c = std::string_view(a[i]).compare(Key::token(i)); c != 0)
+    {
+      return c;
+    }
+  }
+  return a.size() < Key::size ? -1 : (a.size() > Key::size ? 1 : 0);
+}
+
+template <typename T, typename Path>
+inline const T* WarmCache::find_slot(const Path& path) const
+{
+  const PathLess less;
+  auto it = std::lower_bound(slots_.begin(), slots_.end(), path,
+                             [&less](const Slot& slot, const Path& p) { return less(slot.path, p); });
+  for (; it != slots_.end() && !less(path, it->path); ++it)
+  {
+    if (const T* ret = std::any_cast<T>(&it->entry.value))
+    {
+      return ret;
+    }
+  }
+  return nullptr;
+}
+
+template <typename T>
+inline const T* WarmCache::find(const KeyPath& path) const
+{
+  return find_slot<T>(path);
+}
+
+template <typename T, fixed_string Path>
+inline const T* WarmCache::find(StaticKey<Path> key) const
+{
+  return find_slot<T>(key);
+}
+
+template <typename T>
+inline bool WarmCache::get(const KeyPath& path, T& ret) const
+{
+  const T* value = find<T>(path);
+  if (!value)
+  {
+    return false;
+  }
+  ret = *value;
+  return true;
+}
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__IMPL__WARMUP__HPP
@@ -0,0 +1,89 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__KEY_PATH__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__KEY_PATH__H
+
+#include <compare>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief Path of a node from the root of a tree, as the list of its keys. The items of a sequence are addressed by
+ * their index (e.g. "waypoints/3/position"). It is built from a string as the key of get_leaf: the tokens are
+ * separated by any of the delimeters, and the empty tokens are discarded ("/robot/arm_1" == "robot.arm_1").
+ */
+class KeyPath
+{
+public:
+  KeyPath() = default;
+  KeyPath(const std::string& path, const std::string& delimeters = "/.");
+  KeyPath(const char* path) : KeyPath(std::string(path))
+  {
+  }
+  explicit KeyPath(std::vector<std::string> keys);
+
+  const std::vector<std::string>& keys() const
+  {
+    return keys_;
+  }
+  std::size_t size() const
+  {
+    return keys_.size();
+  }
+  bool empty() const
+  {
+    return keys_.empty();
+  }
+  const std::string& operator[](std::size_t i) const
+  {
+    return keys_[i];
+  }
+  const std::string& back() const
+  {
+    return keys_.back();
+  }
+
+  /**
+   * @brief The path without the last key (the root has no parent, and it returns the root)
+   */
+  KeyPath parent() const;
+
+  /**
+   * @brief The path of a child
+   */
+  KeyPath operator/(const std::string& key) const;
+  KeyPath& operator/=(const std::string& key);
+
+  /**
+   * @brief Remove the last key, in place
+   */
+  void pop_back()
+  {
+    keys_.pop_back();
+  }
+
+  /**
+   * @brief True if this is the path of 'other', or of one of its ancestors
+   */
+  bool is_prefix_of(const KeyPath& other) const;
+
+  /**
+   * @brief The keys joined by the delimiter, with a leading delimiter ("/" for the root)
+   */
+  std::string str(const char& delimiter = '/') const;
+
+  bool operator==(const KeyPath& rhs) const = default;
+  std::strong_ordering operator<=>(const KeyPath& rhs) const = default;
+
+private:
+  std::vector<std::string> keys_;
+};
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__KEY_PATH__H
@@ -0,0 +1,131 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__LOAD__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__LOAD__H
+
+#include <cstddef>
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/frozen_node.h>
+#include <cnr_yaml/key_path.h>
+#include <cnr_yaml/mapped_file.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief Options of load_file
+ */
+struct LoadOptions
+{
+  /**
+   * @brief Parse the file in place from a read-only memory mapping. If false, the file is read through a
+   * std::ifstream (as YAML::LoadFile).
+   */
+  bool use_mmap = true;
+
+  /**
+   * @brief Access pattern hinted to the kernel for the mapping (the parser reads the file once, from the beginning)
+   */
+  MappedFile::Advice advice = MappedFile::Advice::SEQUENTIAL;
+
+  /**
+   * @brief Directory of the persistent parse cache (see parse_cache.h). If empty, the cache is not used. The cache
+   * always maps the file, whatever use_mmap.
+   */
+  std::string cache_directory;
+};
+
+/**
+ * @brief Load a YAML file. This is the entry point of the library for the files: it is YAML::LoadFile, without the
+ * buffering copies of the std::ifstream.
+ *
+ * @param path
+ * @param node
+ * @param what
+ * @param options
+ * @return true
+ * @return false if the file cannot be read, or if it is not a valid YAML
+ */
+bool load_file(const std::string& path, YAML::Node& node, std::string& what, const LoadOptions& options = LoadOptions());
+
+/**
+ * @brief Load a YAML file as a frozen tree. The file is parsed directly from the events (see Document), and, on a
+ * hit of the parse cache, the entry is memory-mapped without any parsing.
+ */
+bool load_file(const std::string& path, FrozenNode& root, std::string& what, const LoadOptions& options = LoadOptions());
+
+/**
+ * @brief Load many files concurrently. The nodes are returned in the order of the paths, whatever the number of
+ * threads.
+ *
+ * @param paths
+ * @param nodes
+ * @param what: the errors of all the files that cannot be loaded, in the order of the paths
+ * @param n_threads: 0 means one thread per core (never more threads than files)
+ * @param options
+ * @return true
+ * @return false if any file cannot be loaded
+ */
+bool load_files(const std::vector<std::string>& paths, std::vector<YAML::Node>& nodes, std::string& what,
+                const std::size_t& n_threads = 0, const LoadOptions& options = LoadOptions());
+
+/**
+ * @brief Load many files concurrently, and merge them in the order of the paths with merge_nodes (the latter files
+ * override the former ones)
+ */
+bool load_and_merge_files(const std::vector<std::string>& paths, YAML::Node& merged, std::string& what,
+                          const std::size_t& n_threads = 0, const LoadOptions& options = LoadOptions());
+
+/**
+ * @brief For each leaf of a merged tree, the file that set it
+ */
+using Provenance = std::map<KeyPath, std::string>;
+
+/**
+ * @brief Load a conf.d directory: the regular files whose name matches the glob pattern (fnmatch, e.g. "*.yaml"; the
+ * hidden files are skipped) are loaded concurrently, and merged in the lexical order of their names with the rules
+ * of merge_nodes (the latter files override the former ones). The subdirectories are not entered.
+ *
+ * @param directory
+ * @param pattern
+ * @param merged: a null node if no file matches
+ * @param what
+ * @param provenance: if not null, it is filled while merging, with the file of each leaf (a scalar, a sequence or
+ * an empty map) of the merged tree
+ * @param n_threads: as in load_files
+ * @param options
+ * @return true
+ * @return false if the directory cannot be listed, or if any file cannot be loaded
+ */
+bool load_directory(const std::string& directory, const std::string& pattern, YAML::Node& merged, std::string& what,
+                    Provenance* provenance = nullptr, const std::size_t& n_threads = 0,
+                    const LoadOptions& options = LoadOptions());
+
+/**
+ * @brief Load only a subtree of a large file. The events outside the requested path are discarded without building
+ * any node, and the parsing stops at the end of the subtree. The subtree is always loaded recursively, so that a
+ * trailing "**" token in the key is accepted and ignored. The empty key is the whole document.
+ *
+ * @param input
+ * @param key
+ * @param subtree
+ * @param what
+ * @return true
+ * @return false if the stream is not valid until the end of the subtree, or if the key is missing
+ */
+bool load_subtree(std::istream& input, const KeyPath& key, YAML::Node& subtree, std::string& what);
+
+/**
+ * @brief Same as above, for a file
+ */
+bool load_subtree(const std::string& path, const KeyPath& key, YAML::Node& subtree, std::string& what);
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__LOAD__H
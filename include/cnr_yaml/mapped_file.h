@@ -0,0 +1,102 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__MAPPED_FILE__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__MAPPED_FILE__H
+
+#include <cstddef>
+#include <cstdint>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief Read-only memory mapping of a whole file. The mapping is released by the destructor.
+ */
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& rhs) noexcept;
+  MappedFile& operator=(MappedFile&& rhs) noexcept;
+
+  /**
+   * @brief Map the file
+   *
+   * @param path
+   * @param what
+   * @return true
+   * @return false
+   */
+  bool open(const std::string& path, std::string& what);
+  void close();
+
+  enum class Advice
+  {
+    NORMAL,
+    SEQUENTIAL,  // read-ahead aggressively, and drop the pages behind
+    RANDOM,      // no read-ahead
+    WILLNEED     // start reading the whole file in the background
+  };
+
+  /**
+   * @brief Hint the kernel about the access pattern (madvise). It is only a hint: the errors are ignored.
+   */
+  void advise(const Advice& advice) const;
+
+  bool is_open() const
+  {
+    return open_;
+  }
+  const char* data() const
+  {
+    return data_;
+  }
+  std::size_t size() const
+  {
+    return size_;
+  }
+  std::string_view view() const
+  {
+    return std::string_view(data_, size_);
+  }
+
+  /**
+   * @brief Last modification time of the file when it was mapped [ns since the epoch]
+   */
+  std::int64_t mtime() const
+  {
+    return mtime_;
+  }
+
+private:
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::int64_t mtime_ = 0;
+  bool open_ = false;
+};
+
+/**
+ * @brief Read-only std::streambuf over a memory range (e.g. a MappedFile), so that a std::istream reads the bytes
+ * in place, without any copy. The range must outlive the buffer.
+ */
+class ViewStreamBuf : public std::streambuf
+{
+public:
+  explicit ViewStreamBuf(std::string_view view);
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+};
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__MAPPED_FILE__H
@@ -5,6 +5,7 @@
 #include <vector>
 #include <yaml-cpp/yaml.h>
 
+#include <cnr_yaml/key_path.h>
 #include <cnr_yaml/type_traits.h>
 
 namespace cnr
@@ -88,6 +89,19 @@ void get_nodes_tree(const std::string& ns, const YAML::Node& node,
  */
 std::vector<std::pair<std::string, YAML::Node>> toNodeList(const YAML::Node& root);
 
+/**
+ * @brief Compare two versions of a tree. It returns the new version where the unchanged subtrees are the nodes of
+ * the previous version (same identity, see YAML::Node::is), so that the caches built on them stay valid.
+ *
+ * @param previous
+ * @param next
+ * @param changed: the paths of the nodes that have been added, removed or modified (the deepest ones)
+ * @param root: the path of the compared nodes
+ * @return YAML::Node
+ */
+YAML::Node diff_nodes(const YAML::Node& previous, const YAML::Node& next, std::vector<KeyPath>& changed,
+                      const KeyPath& root = KeyPath());
+
 }  // namespace yaml
 }  // namespace cnr
 
@@ -0,0 +1,52 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__OVERRIDES__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__OVERRIDES__H
+
+#include <string>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <yaml-cpp/yaml.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief The command line options of the overrides, to be added to the options of the application:
+ *
+ * --set path=value   (repeatable) the value is parsed as YAML ("1.2", "[1, 2]", "{p: 1}", "'007'" for a string)
+ * --values file.yaml (repeatable) a YAML file, loaded with load_file
+ *
+ * The path is split as the keys of get_leaf ("robot/arm/max_vel" or "robot.arm.max_vel").
+ */
+boost::program_options::options_description override_options();
+
+/**
+ * @brief Build the override tree from the parsed command line. The options are applied in the order of the command
+ * line (the latter ones override the former ones, with the rules of merge_nodes); each run of consecutive --set is
+ * built in a single pass, sharing the maps of the common path prefixes. The other options are ignored.
+ *
+ * @param parsed
+ * @param overrides: a null node if there are no overrides
+ * @param what
+ * @return true
+ * @return false if a --set is malformed, if a path is set both as a leaf and as a map in the same run of --set, or
+ * if a --values file cannot be loaded
+ */
+bool make_overrides(const boost::program_options::parsed_options& parsed, YAML::Node& overrides, std::string& what);
+
+/**
+ * @brief Same as above, parsing the command line. The options not described by override_options() are ignored, so
+ * that the application can parse them as well.
+ */
+bool parse_overrides(int argc, const char* const argv[], YAML::Node& overrides, std::string& what);
+
+/**
+ * @brief Parse the overrides, and merge them into the configuration (merge_nodes(config, overrides))
+ */
+bool apply_overrides(int argc, const char* const argv[], YAML::Node& config, std::string& what);
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__OVERRIDES__H
@@ -0,0 +1,96 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__PARSE_CACHE__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__PARSE_CACHE__H
+
+#include <cstdint>
+#include <string>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/frozen_node.h>
+#include <cnr_yaml/mapped_file.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * The parse cache stores the parsed files in a directory, as frozen snapshots (see snapshot.h), so that an
+ * unchanged file is never parsed again, by any process. An entry is keyed by the path of the file, and it is valid
+ * only if the modification time, the size and the XXH64 hash of the content match. The entries are written in a
+ * temporary file and renamed, so that concurrent processes never read a partial entry.
+ *
+ * It is used by load_file() when LoadOptions::cache_directory is set.
+ */
+namespace cache
+{
+constexpr char MAGIC[8] = { 'C', 'N', 'R', 'Y', 'C', 'A', 'C', 'H' };
+constexpr std::uint32_t VERSION = 1;
+
+/**
+ * @brief Header of an entry, followed by the frozen blob
+ */
+struct Header
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t frozen_version;
+  std::int64_t mtime;
+  std::uint64_t file_size;
+  std::uint64_t content_hash;
+  std::uint64_t path_hash;
+  std::uint64_t blob_size;
+  std::uint64_t reserved;
+};
+static_assert(sizeof(Header) % 8 == 0, "The frozen blob must be aligned to 8 bytes");
+
+/**
+ * @brief Path of the entry of a file
+ */
+std::string entry_path(const std::string& cache_directory, const std::string& path);
+
+/**
+ * @brief Look for a valid entry of the (mapped) file
+ *
+ * @param cache_directory
+ * @param path
+ * @param file: the mapped content of the file
+ * @param root: the frozen tree, that maps the entry
+ * @return true on a hit
+ * @return false on a miss
+ */
+bool lookup(const std::string& cache_directory, const std::string& path, const MappedFile& file, FrozenNode& root);
+
+/**
+ * @brief Store the entry of the (mapped) file
+ *
+ * @return false if the entry cannot be written (the error is in 'what')
+ */
+bool store(const std::string& cache_directory, const std::string& path, const MappedFile& file,
+           const FrozenNode& root, std::string& what);
+
+/**
+ * @brief Same as above: the tree is frozen first (a tree that cannot be frozen is a store error)
+ */
+bool store(const std::string& cache_directory, const std::string& path, const MappedFile& file,
+           const YAML::Node& root, std::string& what);
+
+}  // namespace cache
+
+/**
+ * @brief Counters of the parse cache of the process
+ */
+struct CacheStats
+{
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  std::uint64_t stores = 0;
+  std::uint64_t errors = 0;  // entries that could not be written
+};
+
+CacheStats cache_stats();
+void reset_cache_stats();
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__PARSE_CACHE__H
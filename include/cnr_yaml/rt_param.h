@@ -0,0 +1,101 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__RT_PARAM__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__RT_PARAM__H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/frozen_node.h>
+#include <cnr_yaml/key_path.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief A parameter pre-resolved for a real-time loop. The key is resolved, and the value decoded, out of the loop
+ * (load() and set(), that may allocate and lock). The real-time thread reads the last value with get(), that does not
+ * allocate, lock, or throw.
+ *
+ * The value is exchanged through a triple buffer: the writer fills its own slot and swaps it with the middle one, the
+ * reader swaps the middle slot with its own one when it is marked as new. Both sides are wait-free, and the reader
+ * never sees a partial update. There must be a single reader thread, while the writers are serialized.
+ *
+ * @code
+ * cnr::yaml::Param<Eigen::VectorXd> gains("controller/gains");
+ * if (!gains.load(config, what)) ...  // configuration time
+ *
+ * // 1 kHz loop
+ * const Eigen::VectorXd& kp = gains.get();
+ *
+ * // reload thread
+ * gains.load(config.snapshot()->root, what);
+ * @endcode
+ *
+ * @tparam T: any type decoded by cnr::yaml::get
+ */
+template <typename T>
+class Param
+{
+public:
+  explicit Param(const KeyPath& key);
+  Param(const Param&) = delete;
+  Param& operator=(const Param&) = delete;
+
+  const KeyPath& key() const
+  {
+    return key_;
+  }
+
+  /**
+   * @brief Resolve the key in the configuration, decode the value, and publish it (non real-time)
+   *
+   * @param config
+   * @param what
+   * @param implicit_cast_if_possible
+   * @return true
+   * @return false if the key is missing, or if the value cannot be decoded (the published value is not changed)
+   */
+  bool load(const YAML::Node& config, std::string& what, const bool& implicit_cast_if_possible = true);
+  bool load(const FrozenNode& config, std::string& what, const bool& implicit_cast_if_possible = true);
+
+  /**
+   * @brief Publish a value (non real-time)
+   */
+  void set(const T& value);
+
+  /**
+   * @brief The last published value (real-time). The reference is valid until the next call of get().
+   */
+  const T& get() noexcept;
+
+  /**
+   * @brief True if a value has been published after the last get()
+   */
+  bool updated() const noexcept
+  {
+    return middle_.load(std::memory_order_relaxed) & DIRTY;
+  }
+
+private:
+  static constexpr std::uint8_t INDEX = 0x3;
+  static constexpr std::uint8_t DIRTY = 0x4;
+
+  KeyPath key_;
+  std::array<T, 3> slots_{};
+  std::uint8_t front_ = 0;                // owned by the reader
+  std::uint8_t back_ = 1;                 // owned by the writer
+  std::atomic<std::uint8_t> middle_{ 2 };  // the exchanged slot, and the DIRTY flag
+  std::mutex writer_mtx_;
+};
+
+}  // namespace yaml
+}  // namespace cnr
+
+#include <cnr_yaml/impl/rt_param.hpp>
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__RT_PARAM__H
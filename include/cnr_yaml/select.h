@@ -0,0 +1,109 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__SELECT__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__SELECT__H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/key_path.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief A node selected by a query, and its path
+ */
+struct Match
+{
+  KeyPath path;
+  YAML::Node node;
+};
+
+/**
+ * @brief A compiled query over the key paths of a tree. It is compiled once, and it can be applied to many trees
+ * (and shared among threads).
+ *
+ * In GLOB mode, the pattern is a sequence of keys separated by '/' (the leading '/' is optional). Each key is either
+ * a literal, a fnmatch pattern ("arm_*", "joint_[0-9]"), or "**", that matches zero or more keys. The elements of
+ * the sequences have their index as key.
+ *
+ * In REGEX mode, the pattern (std::regex, ECMAScript syntax) must match the whole path, written as "/a/b/c".
+ *
+ * The descent is pruned as soon as no match is possible below a node: in GLOB mode the literal keys are looked up
+ * directly, and in REGEX mode the subtrees whose path diverges from the literal prefix of the regex (e.g. "/arm_1/"
+ * for "^/arm_1/joints/.+") are skipped.
+ *
+ * @code
+ * cnr::yaml::Selector limits;
+ * if (!limits.compile("arm/joints/joint_[0-9]/limits", cnr::yaml::Selector::Mode::GLOB, what)) ...
+ * for (const auto& m : limits.select(node))
+ * {
+ *   std::cout << m.path.str() << ": " << m.node << std::endl;
+ * }
+ * @endcode
+ */
+class Selector
+{
+public:
+  enum class Mode
+  {
+    GLOB,
+    REGEX
+  };
+
+  Selector() = default;
+
+  /**
+   * @brief Compile the pattern
+   *
+   * @param pattern
+   * @param mode
+   * @param what
+   * @return true
+   * @return false if the pattern is not valid
+   */
+  bool compile(const std::string& pattern, const Mode& mode, std::string& what);
+
+  /**
+   * @brief The nodes whose path matches the pattern, in depth-first order. Empty if the selector is not compiled.
+   */
+  std::vector<Match> select(const YAML::Node& node) const;
+
+  /**
+   * @brief Test a single path
+   */
+  bool matches(const KeyPath& path) const;
+
+  const std::string& pattern() const
+  {
+    return pattern_;
+  }
+
+  struct Compiled;
+
+private:
+  std::string pattern_;
+  std::shared_ptr<const Compiled> compiled_;
+};
+
+/**
+ * @brief Compile the pattern, and select the nodes. To apply the same pattern to many trees, compile a Selector.
+ *
+ * @param node
+ * @param pattern
+ * @param matches
+ * @param what
+ * @param mode
+ * @return true
+ * @return false if the pattern is not valid
+ */
+bool select(const YAML::Node& node, const std::string& pattern, std::vector<Match>& matches, std::string& what,
+            const Selector::Mode& mode = Selector::Mode::GLOB);
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__SELECT__H
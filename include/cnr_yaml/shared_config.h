@@ -0,0 +1,251 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__SHARED_CONFIG__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__SHARED_CONFIG__H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <version>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/frozen_node.h>
+#include <cnr_yaml/key_path.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief A configuration shared by many reader threads and updated by one or more writers, in the RCU style: each
+ * update freezes the new tree into an immutable snapshot (a FrozenNode), and publishes it with an atomic swap of a
+ * std::shared_ptr. The readers never see a partial update, and a snapshot stays valid as long as a reader holds it.
+ *
+ * A YAML::Node must not be shared among threads (even the const reads touch the reference counts of the shared
+ * memory); the snapshots have no mutable state, and any number of threads can read them.
+ *
+ * @code
+ * cnr::yaml::SharedConfig config(YAML::LoadFile("robot.yaml"));
+ *
+ * // reader thread
+ * cnr::yaml::SharedConfig::Reader reader(config);
+ * double max_vel = 0;
+ * std::string what;
+ * if (!cnr::yaml::get(reader.get()["robot"]["max_vel"], max_vel, what, false)) { ... }
+ *
+ * // reloader thread
+ * config.merge(YAML::LoadFile("override.yaml"));
+ * @endcode
+ *
+ * The components that react to the changes of a subtree subscribe to its path: the subscribers are called by a
+ * dispatcher thread with the changed paths and the new values. The updates published while the dispatcher is busy are
+ * coalesced in a single notification, and so are the edits of a Batch.
+ *
+ * @code
+ * config.subscribe<Eigen::VectorXd>("robot/arm/gains", [](const Eigen::VectorXd& gains, const auto& notification) {
+ *   controller.set_gains(gains);
+ * });
+ * cnr::yaml::SharedConfig::Batch batch(config);
+ * batch.set("robot/arm/gains", Eigen::Vector3d(1, 2, 3), what);
+ * batch.set("robot/arm/max_vel", 2.0, what);
+ * batch.commit(what);  // one snapshot, and one notification
+ * @endcode
+ */
+class SharedConfig
+{
+public:
+  struct Snapshot
+  {
+    FrozenNode root;
+    std::uint64_t version = 0;
+  };
+
+  /**
+   * @brief What a subscriber receives: the paths of the changed keys under its prefix (or the path of an ancestor
+   * that has been replaced or removed), and the new subtree at the prefix (undefined if it has been removed)
+   */
+  struct Notification
+  {
+    std::uint64_t version = 0;
+    KeyPath prefix;
+    FrozenNode value;
+    std::vector<KeyPath> changed;
+    std::shared_ptr<const Snapshot> snapshot;
+  };
+
+  using Callback = std::function<void(const Notification& notification)>;
+
+  /**
+   * @brief A set of edits published as a single snapshot, with a single notification. The edits are recorded, and
+   * they are applied by commit() to the configuration current at that time, so that the concurrent updates are not
+   * lost.
+   */
+  class Batch
+  {
+  public:
+    explicit Batch(SharedConfig& config);
+
+    /**
+     * @brief Set the value of a key (encoded with cnr::yaml::set). The missing maps of the path are created.
+     *
+     * @return false if the value cannot be encoded
+     */
+    template <typename T>
+    bool set(const KeyPath& key, const T& value, std::string& what);
+
+    /**
+     * @brief Replace the subtree of a key. The value is copied, so that the node of the caller is left untouched.
+     */
+    void set_leaf(const KeyPath& key, const YAML::Node& value);
+
+    /**
+     * @brief Merge the overrides into the configuration (merge_nodes). The overrides are copied.
+     */
+    void merge(const YAML::Node& overrides);
+
+    bool empty() const
+    {
+      return edits_.empty();
+    }
+
+    /**
+     * @brief Apply the edits, publish the result and clear the batch
+     *
+     * @return the version of the new snapshot, or 0 if an edit cannot be applied (e.g. a key under a scalar): nothing
+     * is published then
+     */
+    std::uint64_t commit(std::string& what);
+
+  private:
+    struct Edit
+    {
+      KeyPath key;
+      YAML::Node value;
+      bool merge = false;
+    };
+
+    SharedConfig& config_;
+    std::vector<Edit> edits_;
+  };
+
+  /**
+   * @brief A cache of the last snapshot, for a single reader thread. get() costs one atomic load of the version as
+   * long as no update is published, and it takes the new snapshot otherwise.
+   */
+  class Reader
+  {
+  public:
+    explicit Reader(const SharedConfig& config);
+
+    const FrozenNode& get();
+    std::uint64_t version() const
+    {
+      return snapshot_->version;
+    }
+
+  private:
+    const SharedConfig& config_;
+    std::shared_ptr<const Snapshot> snapshot_;
+  };
+
+  /**
+   * @brief An empty configuration (an undefined root), with version 0
+   */
+  SharedConfig();
+  explicit SharedConfig(const YAML::Node& config);
+  ~SharedConfig();
+  SharedConfig(const SharedConfig&) = delete;
+  SharedConfig& operator=(const SharedConfig&) = delete;
+
+  /**
+   * @brief The current snapshot
+   */
+  std::shared_ptr<const Snapshot> snapshot() const;
+
+  /**
+   * @brief The version of the current snapshot. It is increased by each update.
+   */
+  std::uint64_t version() const
+  {
+    return version_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Replace the configuration. The tree is frozen before the swap, so that the readers are never blocked by
+   * the copy.
+   *
+   * @return the version of the new snapshot
+   */
+  std::uint64_t publish(const YAML::Node& config);
+  std::uint64_t publish(const FrozenNode& config);
+
+  /**
+   * @brief Merge the overrides into the current configuration (merge_nodes), and publish the result. The writers are
+   * serialized, so that concurrent merges are not lost.
+   */
+  std::uint64_t merge(const YAML::Node& overrides);
+
+  /**
+   * @brief Set the value of a key, or replace its subtree, and publish the result (a Batch of a single edit)
+   *
+   * @return the version of the new snapshot, or 0 on failure
+   */
+  template <typename T>
+  std::uint64_t set(const KeyPath& key, const T& value, std::string& what);
+  std::uint64_t set_leaf(const KeyPath& key, const YAML::Node& value, std::string& what);
+
+  /**
+   * @brief Call the callback when a key under the prefix changes. The callbacks are called in order by the dispatcher
+   * thread (started by the first subscription), and they must not subscribe or unsubscribe.
+   *
+   * @return the id to unsubscribe
+   */
+  std::size_t subscribe(const KeyPath& prefix, const Callback& callback);
+
+  /**
+   * @brief Same as above, with the new value of the prefix decoded as a T (the notifications whose value cannot be
+   * decoded, e.g. because the key has been removed, are skipped)
+   */
+  template <typename T>
+  std::size_t subscribe(const KeyPath& prefix, const std::function<void(const T& value, const Notification&)>& callback);
+
+  /**
+   * @brief Remove a subscriber: it is not called anymore when unsubscribe returns
+   */
+  void unsubscribe(const std::size_t& id);
+
+private:
+  struct Dispatcher;
+
+  std::uint64_t store(const FrozenNode& root);
+
+  /**
+   * @brief Wake up the dispatcher if a subscriber is interested in the touched paths (the empty path touches the whole
+   * tree). It is called by the writers, with the writer lock. The touched paths are kept for the dispatcher, that
+   * compares the snapshots only where they intersect the subscribed prefixes.
+   */
+  void notify(const KeyPath* touched, const std::size_t& n);
+
+  std::mutex writer_mtx_;
+  std::atomic<std::size_t> subscribers_{ 0 };
+  std::unique_ptr<Dispatcher> dispatcher_;
+  std::atomic<std::uint64_t> version_{ 0 };
+#if defined(__cpp_lib_atomic_shared_ptr)
+  std::atomic<std::shared_ptr<const Snapshot>> current_;
+#else
+  mutable std::mutex current_mtx_;
+  std::shared_ptr<const Snapshot> current_;
+#endif
+};
+
+}  // namespace yaml
+}  // namespace cnr
+
+#include <cnr_yaml/impl/shared_config.hpp>
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__SHARED_CONFIG__H
@@ -0,0 +1,53 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__SNAPSHOT__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__SNAPSHOT__H
+
+#include <string>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/frozen_node.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * A snapshot is the frozen blob (see frozen_node.h) written as-is to a file. It is versioned (frozen::VERSION) and
+ * relocatable, so that it is memory-mapped and used without any parsing: many processes on the same host share
+ * the same pages of the page cache.
+ */
+
+/**
+ * @brief Write the snapshot of a tree. The file is written in a temporary file and then renamed, so that a reader
+ * never maps a partially written snapshot.
+ *
+ * @param node
+ * @param path
+ * @param what
+ * @return true
+ * @return false
+ */
+bool save_snapshot(const YAML::Node& node, const std::string& path, std::string& what);
+
+/**
+ * @brief Same as above. If the node is the root of its frozen tree, the blob is written without any conversion.
+ */
+bool save_snapshot(const FrozenNode& node, const std::string& path, std::string& what);
+
+/**
+ * @brief Memory-map a snapshot. The mapping is released when the last FrozenNode of the tree is destroyed.
+ *
+ * @param path
+ * @param root
+ * @param what
+ * @param validate: check all the entries, and not only the header (it touches all the pages of the file). It can be
+ * disabled only for the files written by the same program, since the lookups trust the entries.
+ * @return true
+ * @return false
+ */
+bool load_snapshot(const std::string& path, FrozenNode& root, std::string& what, const bool& validate = true);
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__SNAPSHOT__H
@@ -0,0 +1,159 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__STATIC_KEY__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__STATIC_KEY__H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/frozen_node.h>
+#include <cnr_yaml/hash.h>
+#include <cnr_yaml/key_path.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief A string literal usable as a template argument
+ */
+template <std::size_t N>
+struct fixed_string
+{
+  char data[N]{};
+
+  constexpr fixed_string(const char (&str)[N])
+  {
+    for (std::size_t i = 0; i < N; i++)
+    {
+      data[i] = str[i];
+    }
+  }
+
+  constexpr std::string_view view() const
+  {
+    return std::string_view(data, N - 1);
+  }
+};
+
+/**
+ * @brief A token of a static key: its position in the path, and its fnv1a hash
+ */
+struct StaticToken
+{
+  std::size_t offset;
+  std::size_t size;
+  std::uint64_t hash;
+};
+
+namespace detail
+{
+constexpr bool is_key_delimiter(char c)
+{
+  return c == '/' || c == '.';
+}
+
+constexpr std::size_t count_tokens(std::string_view path)
+{
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < path.size(); i++)
+  {
+    if (!is_key_delimiter(path[i]) && (i == 0 || is_key_delimiter(path[i - 1])))
+    {
+      n++;
+    }
+  }
+  return n;
+}
+
+template <std::size_t N>
+constexpr std::array<StaticToken, N> tokenize(std::string_view path)
+{
+  std::array<StaticToken, N> ret{};
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < path.size();)
+  {
+    if (is_key_delimiter(path[i]))
+    {
+      i++;
+      continue;
+    }
+    std::size_t j = i;
+    while (j < path.size() && !is_key_delimiter(path[j]))
+    {
+      j++;
+    }
+    ret[n++] = StaticToken{ i, j - i, fnv1a(path.substr(i, j - i)) };
+    i = j;
+  }
+  return ret;
+}
+
+}  // namespace detail
+
+/**
+ * @brief A key known at compile time. The path is split as a KeyPath (the delimiters are '/' and '.', and the empty
+ * tokens are discarded), and the tokens and their hashes are computed by the compiler, so that the lookups neither
+ * tokenize nor hash at runtime.
+ *
+ * @code
+ * cnr::yaml::FrozenNode leaf;
+ * if (!cnr::yaml::get_leaf(root, cnr::yaml::key<"robot/arm/max_vel">, leaf, what)) ...
+ * @endcode
+ */
+template <fixed_string Path>
+struct StaticKey
+{
+  static constexpr std::string_view path = Path.view();
+  static constexpr std::size_t size = detail::count_tokens(path);
+  static constexpr std::array<StaticToken, size> tokens = detail::tokenize<size>(path);
+
+  static constexpr std::string_view token(std::size_t i)
+  {
+    return path.substr(tokens[i].offset, tokens[i].size);
+  }
+
+  operator KeyPath() const
+  {
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < size; i++)
+    {
+      keys.emplace_back(token(i));
+    }
+    return KeyPath(std::move(keys));
+  }
+};
+
+template <fixed_string Path>
+inline constexpr StaticKey<Path> key{};
+
+/**
+ * @brief The leaf of a frozen tree. Each token is looked up with its precomputed hash.
+ *
+ * @return the undefined node if the key is missing
+ */
+template <fixed_string Path>
+FrozenNode find(const FrozenNode& node, StaticKey<Path> key);
+
+/**
+ * @brief Same as get_leaf(node, std::string, ...), with a static key
+ */
+template <fixed_string Path>
+bool get_leaf(const FrozenNode& node, StaticKey<Path> key, FrozenNode& leaf, std::string& what);
+
+/**
+ * @brief Same as get_leaf(node, std::string, ...), with a static key. The keys of the maps are compared with the
+ * tokens, without creating any node.
+ */
+template <fixed_string Path>
+bool get_leaf(const YAML::Node& node, StaticKey<Path> key, YAML::Node& leaf, std::string& what);
+
+}  // namespace yaml
+}  // namespace cnr
+
+#include <cnr_yaml/impl/static_key.hpp>
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__STATIC_KEY__H
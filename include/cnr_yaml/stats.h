@@ -0,0 +1,164 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__STATS__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__STATS__H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief The counters of the hot paths. They are compiled in only if the library is built with ENABLE_STATS
+ * (that defines CNR_YAML_ENABLE_STATS for the library and its users); otherwise the instrumentation compiles to
+ * nothing, and stats() returns zeros.
+ *
+ * Each thread increments its own counters (relaxed atomics with a single writer), and stats() sums the counters of
+ * all the threads. The nested calls (e.g. the get of the elements of a sequence) are counted, but only the time of
+ * the outermost call is measured.
+ */
+struct Stats
+{
+  std::uint64_t get_calls = 0;
+  std::uint64_t decode_alternatives = 0;  // the alternatives of the decoding variant that have been tried
+  std::uint64_t decode_exceptions = 0;
+  std::uint64_t get_ns = 0;
+
+  std::uint64_t set_calls = 0;
+  std::uint64_t encode_alternatives = 0;
+  std::uint64_t encode_exceptions = 0;
+  std::uint64_t set_ns = 0;
+
+  std::uint64_t get_leaf_calls = 0;
+  std::uint64_t get_leaf_nodes = 0;  // the nodes visited to resolve the keys
+  std::uint64_t get_leaf_ns = 0;
+
+  std::uint64_t merge_calls = 0;
+  std::uint64_t merge_nodes = 0;  // the nodes visited by merge_nodes (including the recursive calls)
+  std::uint64_t merge_ns = 0;
+
+  std::uint64_t what_bytes = 0;  // the bytes of the error messages returned by the failed calls
+};
+
+/**
+ * @brief True if the library has been built with the counters
+ */
+#if defined(CNR_YAML_ENABLE_STATS)
+inline constexpr bool stats_enabled = true;
+#else
+inline constexpr bool stats_enabled = false;
+#endif
+
+/**
+ * @brief The sum of the counters of all the threads (also of the ones that have exited) since the last reset
+ */
+Stats stats();
+
+/**
+ * @brief Zero the counters. An increment concurrent with the reset may be lost.
+ */
+void reset_stats();
+
+std::ostream& operator<<(std::ostream& os, const Stats& stats);
+
+namespace detail
+{
+
+enum class Counter : std::size_t
+{
+  GET_CALLS,
+  DECODE_ALTERNATIVES,
+  DECODE_EXCEPTIONS,
+  GET_NS,
+  SET_CALLS,
+  ENCODE_ALTERNATIVES,
+  ENCODE_EXCEPTIONS,
+  SET_NS,
+  GET_LEAF_CALLS,
+  GET_LEAF_NODES,
+  GET_LEAF_NS,
+  MERGE_CALLS,
+  MERGE_NODES,
+  MERGE_NS,
+  WHAT_BYTES,
+  SIZE
+};
+
+constexpr std::size_t counters = static_cast<std::size_t>(Counter::SIZE);
+
+struct ThreadCounters
+{
+  std::array<std::atomic<std::uint64_t>, counters> values{};
+  std::array<std::uint32_t, counters> depth{};  // nesting of the timed calls, touched only by the owner thread
+};
+
+/**
+ * @brief The counters of the calling thread. They are registered at the first call, and folded in the totals when
+ * the thread exits.
+ */
+ThreadCounters& thread_counters();
+
+inline void stats_add(Counter counter, std::uint64_t n)
+{
+  // a single writer: a load and a store are enough, and cheaper than a fetch_add
+  auto& value = thread_counters().values[static_cast<std::size_t>(counter)];
+  value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Count a call, and measure its time if it is not nested in another call of the same kind
+ */
+class StatsScope
+{
+public:
+  StatsScope(Counter calls, Counter ns) : counters_(thread_counters()), ns_(static_cast<std::size_t>(ns))
+  {
+    auto& value = counters_.values[static_cast<std::size_t>(calls)];
+    value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (counters_.depth[ns_]++ == 0)
+    {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~StatsScope()
+  {
+    if (--counters_.depth[ns_] == 0)
+    {
+      const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+      auto& value = counters_.values[ns_];
+      value.store(value.load(std::memory_order_relaxed) + static_cast<std::uint64_t>(elapsed.count()),
+                  std::memory_order_relaxed);
+    }
+  }
+
+  StatsScope(const StatsScope&) = delete;
+  StatsScope& operator=(const StatsScope&) = delete;
+
+private:
+  ThreadCounters& counters_;
+  std::size_t ns_;
+  std::chrono::steady_clock::time_point start_{};
+};
+
+}  // namespace detail
+
+}  // namespace yaml
+}  // namespace cnr
+
+#if defined(CNR_YAML_ENABLE_STATS)
+#define CNR_YAML_STATS_ADD(COUNTER, N) ::cnr::yaml::detail::stats_add(::cnr::yaml::detail::Counter::COUNTER, (N))
+#define CNR_YAML_STATS_SCOPE(CALLS, NS)                                                                                \
+  ::cnr::yaml::detail::StatsScope cnr_yaml_stats_scope_(::cnr::yaml::detail::Counter::CALLS,                           \
+                                                        ::cnr::yaml::detail::Counter::NS)
+#else
+#define CNR_YAML_STATS_ADD(COUNTER, N) ((void)0)
+#define CNR_YAML_STATS_SCOPE(CALLS, NS) ((void)0)
+#endif
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__STATS__H
@@ -0,0 +1,109 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__STREAM_READER__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__STREAM_READER__H
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <Eigen/Core>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/key_path.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief Streaming decoder of large files. It reads the events of the YAML::Parser and it fills the bound targets
+ * as the events arrive, without building the tree: the nodes outside the bound paths are scanned and discarded, and
+ * the peak memory is the one of the decoded targets.
+ *
+ * The numeric targets accept a number, a sequence of numbers, or a sequence of sequences of numbers (the rows).
+ * A YAML::Node target receives the whole bound subtree.
+ * The numbers follow the same rules of the YAML::convert<double> of yaml-cpp. The bound paths must not be nested one
+ * in the other (bind returns false), while a path can be bound to many targets. As YAML::Load, only the first document of the stream is read, and the reading stops as soon as all
+ * the bound nodes have been decoded.
+ *
+ * @code
+ * std::vector<double> times;
+ * Eigen::MatrixXd points;
+ * cnr::yaml::StreamReader reader;
+ * reader.bind("trajectory/time_from_start", times);
+ * reader.bind("trajectory/points", points);
+ * if (!reader.read_file("trajectory.yaml", what)) ...
+ * @endcode
+ */
+class StreamReader
+{
+public:
+  /**
+   * @brief Called for each number, with its row and column (the column is 0 for a sequence of numbers)
+   */
+  using ElementCallback = std::function<void(std::size_t row, std::size_t col, double value)>;
+
+  StreamReader();
+  ~StreamReader();
+  StreamReader(const StreamReader&) = delete;
+  StreamReader& operator=(const StreamReader&) = delete;
+  StreamReader(StreamReader&&) noexcept;
+  StreamReader& operator=(StreamReader&&) noexcept;
+
+  /**
+   * @brief The numbers are appended to the (cleared) vector. The rows of a sequence of sequences are concatenated.
+   *
+   * @return false if the path is nested in a bound path, or if a bound path is nested in it: nothing is bound then
+   */
+  bool bind(const KeyPath& path, std::vector<double>& target);
+
+  /**
+   * @brief A sequence of numbers is stored as a column vector, a sequence of sequences as a matrix (the rows must
+   * have the same length). The numbers are written directly in the matrix, without an intermediate buffer.
+   */
+  bool bind(const KeyPath& path, Eigen::MatrixXd& target);
+
+  /**
+   * @brief Each number is passed to the callback, and it is not stored
+   */
+  bool bind(const KeyPath& path, const ElementCallback& callback);
+
+  /**
+   * @brief The bound subtree is built as a YAML::Node. The aliases must refer to anchors inside the subtree.
+   */
+  bool bind(const KeyPath& path, YAML::Node& target);
+
+  /**
+   * @brief Remove all the bindings
+   */
+  void clear();
+
+  /**
+   * @brief Read the stream, and fill the bound targets
+   *
+   * @param input
+   * @param what
+   * @return true
+   * @return false if the stream is not a valid YAML, if a bound node cannot be decoded, or if a bound path is missing
+   */
+  bool read(std::istream& input, std::string& what);
+
+  /**
+   * @brief Same as above, for a file
+   */
+  bool read_file(const std::string& path, std::string& what);
+
+  class Binding;
+
+private:
+  bool add(std::unique_ptr<Binding>&& binding);
+
+  std::vector<std::unique_ptr<Binding>> bindings_;
+};
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__STREAM_READER__H
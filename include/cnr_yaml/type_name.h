@@ -0,0 +1,65 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__TYPE_NAME__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__TYPE_NAME__H
+
+#include <string_view>
+
+namespace cnr
+{
+namespace yaml
+{
+
+namespace detail
+{
+template <typename T>
+constexpr std::string_view raw_type_name() noexcept
+{
+#if defined(__clang__)
+  return __PRETTY_FUNCTION__;  // "... raw_type_name() [T = double]"
+#elif defined(__GNUC__)
+  return __PRETTY_FUNCTION__;  // "... raw_type_name() [with T = double; std::string_view = ...]"
+#elif defined(_MSC_VER)
+  return __FUNCSIG__;  // "... raw_type_name<double>(void) noexcept"
+#else
+  return "";
+#endif
+}
+
+constexpr std::string_view slice_type_name(std::string_view raw) noexcept
+{
+#if defined(__clang__)
+  const std::size_t begin = raw.find("[T = ") + 5;
+  const std::size_t end = raw.rfind(']');
+#elif defined(__GNUC__)
+  const std::size_t begin = raw.find("[with T = ") + 10;
+  const std::size_t end = raw.find(';', begin) == std::string_view::npos ? raw.rfind(']') : raw.find(';', begin);
+#elif defined(_MSC_VER)
+  const std::size_t begin = raw.find("raw_type_name<") + 14;
+  const std::size_t end = raw.rfind(">(void)");
+#else
+  const std::size_t begin = 0;
+  const std::size_t end = 0;
+#endif
+  return raw.substr(begin, end - begin);
+}
+
+}  // namespace detail
+
+/**
+ * @brief The name of a type (with its cv and reference qualifiers), sliced at compile time from the signature of a
+ * function template. It replaces boost::typeindex::type_id_with_cvr<T>().pretty_name(), that demangles (and
+ * allocates) at each call. The spelling is the one of the compiler (e.g. "std::__cxx11::basic_string<char>").
+ *
+ * @tparam T
+ * @return std::string_view: it refers to static storage
+ */
+template <typename T>
+constexpr std::string_view type_name() noexcept
+{
+  constexpr std::string_view name = detail::slice_type_name(detail::raw_type_name<T>());
+  return name;
+}
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__TYPE_NAME__H
@@ -4,7 +4,7 @@
 #include <cstddef>
 #include <stdexcept>
 #include <Eigen/Core>
-#include <boost/type_index.hpp>
+#include <cnr_yaml/type_name.h>
 #include <type_traits>
 #include <vector>
 #include <string>
@@ -410,8 +410,8 @@ implicit_cast(const F&)
 {
   std::string err = __PRETTY_FUNCTION__ + std::string(":") + std::to_string(__LINE__) + ": " +
                     "Umatched implicit cast from '" +
-                    boost::typeindex::type_id_with_cvr<decltype(F())>().pretty_name() + "' to '" +
-                    boost::typeindex::type_id_with_cvr<decltype(T())>().pretty_name() + "'";
+                    std::string(cnr::yaml::type_name<decltype(F())>()) + "' to '" +
+                    std::string(cnr::yaml::type_name<decltype(T())>()) + "'";
   throw std::runtime_error(err.c_str());
   return T();
 }
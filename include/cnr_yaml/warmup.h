@@ -0,0 +1,201 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__WARMUP__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__WARMUP__H
+
+#include <any>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/frozen_node.h>
+#include <cnr_yaml/key_path.h>
+#include <cnr_yaml/static_key.h>
+#include <cnr_yaml/type_name.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief A key to be warmed up: its path, and the type of its value. An empty type means that the key is only
+ * resolved.
+ */
+struct ManifestEntry
+{
+  KeyPath path;
+  std::string type;
+};
+
+using Manifest = std::vector<ManifestEntry>;
+
+/**
+ * @brief Read a manifest: a YAML sequence of {path, type} (the type is optional), as written by write_hot_keys
+ *
+ * @code
+ * - {path: /robot/arm/max_vel, type: double}
+ * - {path: /robot/arm/gains, type: Eigen::VectorXd}
+ * - {path: /robot/name}
+ * @endcode
+ */
+bool parse_manifest(const YAML::Node& node, Manifest& manifest, std::string& what);
+bool load_manifest(const std::string& path, Manifest& manifest, std::string& what);
+
+/**
+ * @brief The decoder of a type, as used by warmup
+ */
+using WarmupDecoder = std::function<bool(const FrozenNode& node, std::any& value, std::string& what)>;
+
+/**
+ * @brief Register the decoder of a type under a name. The non-numeric common types (bool, std::string and their
+ * std::vector) are registered both with their short name ("string", "std::vector<bool>", ...) and with their
+ * type_name<T>().
+ */
+void register_warmup_decoder(const std::string& type, const WarmupDecoder& decoder);
+
+/**
+ * @brief Register a type under its type_name<T>() and the given aliases
+ */
+template <typename T>
+void register_warmup_type(const std::vector<std::string>& aliases = {});
+
+/**
+ * @brief Register the numeric types (double, int, their std::vector, Eigen::VectorXd, Eigen::MatrixXd,
+ * Eigen::Vector3d, the 6 and 7 sized vectors) with their short name and their type_name<T>(). It is inline, so
+ * that the decoders are compiled with the specializations of decoding_type_variant_holder seen by the caller.
+ */
+void register_numeric_warmup_types();
+
+/**
+ * @brief The keys resolved and decoded by warmup. The reads do not lock, and the cache can be read by many threads.
+ * They do not allocate either when the path is a static key (cnr::yaml::key<"...">) or a KeyPath built once by the
+ * caller: a string converted to a KeyPath at each call is tokenized (and allocated) at each call.
+ *
+ * The entries are kept in one vector sorted by path, so that a lookup is a binary search over contiguous memory. The
+ * pointers returned by find are valid until the next add (or warmup) on the cache: the real-time threads take them
+ * once, after the warm-up, and then read the values without any lookup.
+ */
+class WarmCache
+{
+public:
+  struct Entry
+  {
+    std::string type;
+    FrozenNode leaf;
+    std::any value;  // empty for the keys that are only resolved
+  };
+
+  /**
+   * @brief The resolved node of a path (undefined if the path has not been warmed up)
+   */
+  FrozenNode leaf(const KeyPath& path) const;
+
+  /**
+   * @brief The decoded value of a path, if it has been warmed up as a T
+   */
+  template <typename T>
+  const T* find(const KeyPath& path) const;
+  template <typename T, fixed_string Path>
+  const T* find(StaticKey<Path> key) const;
+
+  /**
+   * @brief Copy the decoded value of a path (false if it has not been warmed up as a T)
+   */
+  template <typename T>
+  bool get(const KeyPath& path, T& ret) const;
+
+  std::size_t size() const
+  {
+    return slots_.size();
+  }
+
+  /**
+   * @brief Add the entry of a path, or replace the one of the same type
+   */
+  void add(const KeyPath& path, Entry&& entry);
+
+  void reserve(std::size_t n)
+  {
+    slots_.reserve(n);
+  }
+
+private:
+  /**
+   * @brief The order of the KeyPath, that compares the static keys with the paths without converting them
+   */
+  struct PathLess
+  {
+    using is_transparent = void;
+
+    bool operator()(const KeyPath& a, const KeyPath& b) const
+    {
+      return a < b;
+    }
+    template <fixed_string Path>
+    bool operator()(const KeyPath& a, StaticKey<Path> b) const
+    {
+      return compare(a, b) < 0;
+    }
+    template <fixed_string Path>
+    bool operator()(StaticKey<Path> a, const KeyPath& b) const
+    {
+      return compare(b, a) > 0;
+    }
+    template <fixed_string Path>
+    static int compare(const KeyPath& a, StaticKey<Path> b);
+  };
+
+  struct Slot
+  {
+    KeyPath path;
+    Entry entry;
+  };
+
+  /**
+   * @brief The first value of the type T among the entries of a path (they are adjacent in slots_)
+   */
+  template <typename T, typename Path>
+  const T* find_slot(const Path& path) const;
+
+  std::vector<Slot> slots_;  // sorted by path, the entries of a path in the order of insertion
+};
+
+/**
+ * @brief Resolve and decode all the keys of a manifest, so that the first access of the real-time threads finds the
+ * values already decoded and the tree already touched. The keys are processed by n_threads workers (a frozen tree can
+ * be read by many threads), and all the failures are reported together: the keys that succeeded are in the cache
+ * anyway.
+ *
+ * @code
+ * cnr::yaml::Manifest manifest;
+ * cnr::yaml::load_manifest("hot_keys.yaml", manifest, what);
+ * cnr::yaml::WarmCache cache;
+ * if (!cnr::yaml::warmup(root, manifest, cache, what)) { std::cerr << what; }
+ * const Eigen::VectorXd* gains = cache.find<Eigen::VectorXd>(cnr::yaml::key<"robot/arm/gains">);
+ * @endcode
+ *
+ * @param root
+ * @param manifest
+ * @param cache
+ * @param what: a message for each key that cannot be resolved or decoded, or whose type is not registered, in the
+ * order of the manifest
+ * @param n_threads: 0 means one thread per core (never more threads than keys)
+ * @return true
+ * @return false if any key failed
+ */
+bool warmup(const FrozenNode& root, const Manifest& manifest, WarmCache& cache, std::string& what,
+            const std::size_t& n_threads = 1);
+
+/**
+ * @brief Same as above: the tree is frozen first
+ */
+bool warmup(const YAML::Node& root, const Manifest& manifest, WarmCache& cache, std::string& what,
+            const std::size_t& n_threads = 1);
+
+}  // namespace yaml
+}  // namespace cnr
+
+#include <cnr_yaml/impl/warmup.hpp>
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__WARMUP__H
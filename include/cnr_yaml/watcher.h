@@ -0,0 +1,115 @@
+#ifndef CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__WATCHER__H
+#define CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__WATCHER__H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/key_path.h>
+#include <cnr_yaml/load.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief Hot reload of a set of files. The files are watched with inotify (the directories are watched, so that the
+ * files replaced by a rename, as most of the editors do, are still followed), the bursts of writes are debounced,
+ * and only the changed files are parsed again. The files are then merged again, and the subscribers are called with
+ * the paths of the changed keys. The unchanged subtrees of the merged configuration keep their identity (see
+ * diff_nodes), so that the caches built on them stay valid.
+ *
+ * If a changed file cannot be loaded (e.g. it is being written), the previous version is kept, and the error is
+ * available through last_error(). The subscribers are called from the thread of the watcher, with the merged
+ * configuration itself: its subtrees are shared with the trees of the files, so it must be read only (a subscriber
+ * that needs to edit it works on a YAML::Clone).
+ */
+class Watcher
+{
+public:
+  using Callback = std::function<void(const YAML::Node& config, const std::vector<KeyPath>& changed)>;
+  using Merge = std::function<YAML::Node(const std::vector<YAML::Node>& nodes)>;
+
+  struct Options
+  {
+    std::chrono::milliseconds debounce{ 100 };
+
+    /**
+     * @brief Merge of the files. By default, they are merged in order with merge_nodes (the latter files override
+     * the former ones).
+     */
+    Merge merge;
+    LoadOptions load;
+  };
+
+  Watcher() = default;
+  ~Watcher();
+  Watcher(const Watcher&) = delete;
+  Watcher& operator=(const Watcher&) = delete;
+
+  /**
+   * @brief Load the files, and start the watching thread
+   *
+   * @param paths
+   * @param what
+   * @param options
+   * @return true
+   * @return false if a file cannot be loaded, or if the files cannot be watched
+   */
+  bool start(const std::vector<std::string>& paths, std::string& what, const Options& options);
+
+  /**
+   * @brief Same as above, with the default options
+   */
+  bool start(const std::vector<std::string>& paths, std::string& what);
+
+  /**
+   * @brief Stop the watching thread. It is called by the destructor.
+   */
+  void stop();
+
+  /**
+   * @brief Add a subscriber. It returns the id to unsubscribe it.
+   */
+  std::size_t subscribe(const Callback& callback);
+  void unsubscribe(const std::size_t& id);
+
+  /**
+   * @brief A deep copy of the current merged configuration. The caller can edit it: the trees compared by the next
+   * reload are not reached.
+   */
+  YAML::Node config() const;
+  std::string last_error() const;
+
+private:
+  void run();
+  void reload(const std::vector<std::size_t>& files);
+
+  std::vector<std::string> paths_;
+  std::vector<std::pair<int, std::string>> watches_;  // watch descriptor, directory
+  Options options_;
+  int inotify_fd_ = -1;
+  int stop_fd_ = -1;
+  std::atomic<bool> stopping_{ false };
+  std::thread thread_;
+
+  mutable std::mutex mtx_;
+  std::vector<YAML::Node> nodes_;
+  YAML::Node config_;
+  std::string last_error_;
+  std::vector<std::pair<std::size_t, Callback>> subscribers_;
+  std::size_t next_id_ = 0;
+};
+
+}  // namespace yaml
+}  // namespace cnr
+
+#endif  // CNR_YAML_UTILITIES__INCLUDE__CNR_YAML_UTILITIES__WATCHER__H
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/access_profile.h>
+#include <cnr_yaml/key_path.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+// =====================================================================================================================
+// LatencyHistogram
+// =====================================================================================================================
+std::size_t LatencyHistogram::bucket(std::uint64_t ns)
+{
+  if (ns < SUB_BUCKETS)
+  {
+    return static_cast<std::size_t>(ns);
+  }
+  const std::size_t msb = 63 - static_cast<std::size_t>(__builtin_clzll(ns));
+  const std::size_t octave = msb - SUB_BITS + 1;
+  if (octave > OCTAVES)
+  {
+    return BUCKETS - 1;
+  }
+  const std::size_t sub = static_cast<std::size_t>(ns >> (msb - SUB_BITS)) & (SUB_BUCKETS - 1);
+  return octave * SUB_BUCKETS + sub;
+}
+
+std::uint64_t LatencyHistogram::lower(std::size_t bucket)
+{
+  const std::size_t octave = bucket / SUB_BUCKETS;
+  const std::size_t sub = bucket % SUB_BUCKETS;
+  return octave == 0 ? sub : static_cast<std::uint64_t>(SUB_BUCKETS + sub) << (octave - 1);
+}
+
+std::uint64_t LatencyHistogram::upper(std::size_t bucket)
+{
+  const std::size_t octave = bucket / SUB_BUCKETS;
+  return lower(bucket) + (octave == 0 ? 0 : (std::uint64_t(1) << (octave - 1)) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t ns)
+{
+  buckets_[bucket(ns)]++;
+  count_++;
+}
+
+std::uint64_t LatencyHistogram::percentile(double q) const
+{
+  if (count_ == 0)
+  {
+    return 0;
+  }
+  const double clamped = std::clamp(q, 0.0, 1.0);
+  const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped * count_)));
+  std::uint64_t seen = 0;
+  for (std::size_t b = 0; b < BUCKETS; b++)
+  {
+    seen += buckets_[b];
+    if (seen >= rank)
+    {
+      return upper(b);
+    }
+  }
+  return upper(BUCKETS - 1);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+  for (std::size_t b = 0; b < BUCKETS; b++)
+  {
+    buckets_[b] += other.buckets_[b];
+  }
+  count_ += other.count_;
+}
+
+// =====================================================================================================================
+// Recorder
+// =====================================================================================================================
+namespace detail
+{
+std::atomic<bool> access_profiling{ false };
+}
+
+namespace
+{
+
+struct Entry
+{
+  KeyAccess access;
+  std::vector<std::thread::id> threads;
+};
+
+/**
+ * @brief The entries are split in shards by the hash of the path, so that the threads that read different keys
+ * seldom contend the same lock
+ */
+struct Shard
+{
+  std::mutex mtx;
+  std::map<std::string, std::vector<Entry>, std::less<>> paths;
+};
+
+constexpr std::size_t SHARDS = 16;
+
+/**
+ * @brief True if the path is already the str() of its KeyPath: '/' is the only delimeter in it
+ */
+bool is_normalized(std::string_view path, std::string_view delimeters)
+{
+  if (delimeters.find('/') == std::string_view::npos)
+  {
+    return false;
+  }
+  for (const char c : delimeters)
+  {
+    if (c != '/' && path.find(c) != std::string_view::npos)
+    {
+      return false;
+    }
+  }
+  return !path.empty() && path.front() == '/' && path.find("//") == std::string_view::npos &&
+         (path.size() == 1 || path.back() != '/');
+}
+
+std::array<Shard, SHARDS>& shards()
+{
+  // never destroyed: the threads may record after the static destructors
+  static auto* instance = new std::array<Shard, SHARDS>();
+  return *instance;
+}
+
+}  // namespace
+
+namespace detail
+{
+void record_access(std::string_view path, std::string_view type, std::uint64_t ns, std::string_view delimeters)
+{
+  std::string normalized;
+  if (!is_normalized(path, delimeters))
+  {
+    normalized = KeyPath(std::string(path), std::string(delimeters)).str();
+    path = normalized;
+  }
+  Shard& shard = shards()[std::hash<std::string_view>()(path) % SHARDS];
+  std::lock_guard<std::mutex> lock(shard.mtx);
+  auto it = shard.paths.find(path);
+  if (it == shard.paths.end())
+  {
+    it = shard.paths.emplace(std::string(path), std::vector<Entry>()).first;
+  }
+  auto entry = std::find_if(it->second.begin(), it->second.end(), [&](const Entry& e) { return e.access.type == type; });
+  if (entry == it->second.end())
+  {
+    it->second.emplace_back();
+    entry = it->second.end() - 1;
+    entry->access.path = it->first;
+    entry->access.type = std::string(type);
+  }
+  entry->access.lookups++;
+  entry->access.total_ns += ns;
+  entry->access.latency.record(ns);
+  const std::thread::id id = std::this_thread::get_id();
+  if (std::find(entry->threads.begin(), entry->threads.end(), id) == entry->threads.end())
+  {
+    entry->threads.push_back(id);
+    entry->access.threads = entry->threads.size();
+  }
+}
+}  // namespace detail
+
+void enable_access_profiling(const bool& enable)
+{
+  detail::access_profiling.store(enable, std::memory_order_relaxed);
+}
+
+std::vector<KeyAccess> access_report()
+{
+  std::vector<KeyAccess> ret;
+  for (auto& shard : shards())
+  {
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    for (const auto& kv : shard.paths)
+    {
+      for (const auto& entry : kv.second)
+      {
+        ret.push_back(entry.access);
+      }
+    }
+  }
+  std::sort(ret.begin(), ret.end(), [](const KeyAccess& a, const KeyAccess& b) {
+    return a.total_ns != b.total_ns ? a.total_ns > b.total_ns : a.path < b.path;
+  });
+  return ret;
+}
+
+void reset_access_profile()
+{
+  for (auto& shard : shards())
+  {
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    shard.paths.clear();
+  }
+}
+
+void write_access_report(std::ostream& os, const std::size_t& max_rows)
+{
+  const std::vector<KeyAccess> report = access_report();
+  os << std::left << std::setw(48) << "path" << std::setw(24) << "type" << std::right << std::setw(10) << "lookups"
+     << std::setw(8) << "threads" << std::setw(14) << "total [ns]" << std::setw(10) << "p50 [ns]" << std::setw(10)
+     << "p99 [ns]" << "\n";
+  const std::size_t rows = max_rows ? std::min(max_rows, report.size()) : report.size();
+  for (std::size_t i = 0; i < rows; i++)
+  {
+    const KeyAccess& a = report[i];
+    os << std::left << std::setw(48) << a.path << std::setw(24) << (a.type.empty() ? "-" : a.type) << std::right
+       << std::setw(10) << a.lookups << std::setw(8) << a.threads << std::setw(14) << a.total_ns << std::setw(10)
+       << a.latency.percentile(0.5) << std::setw(10) << a.latency.percentile(0.99) << "\n";
+  }
+  if (rows < report.size())
+  {
+    os << "... " << report.size() - rows << " more paths\n";
+  }
+}
+
+void write_hot_keys(std::ostream& os, const std::size_t& max_keys)
+{
+  const std::vector<KeyAccess> report = access_report();
+  const std::size_t rows = max_keys ? std::min(max_keys, report.size()) : report.size();
+  // emitted by yaml-cpp, that quotes and escapes the keys as needed
+  YAML::Emitter out;
+  out << YAML::BeginSeq;
+  for (std::size_t i = 0; i < rows; i++)
+  {
+    out << YAML::Flow << YAML::BeginMap << YAML::Key << "path" << YAML::Value << report[i].path;
+    if (!report[i].type.empty())
+    {
+      out << YAML::Key << "type" << YAML::Value << report[i].type;
+    }
+    out << YAML::EndMap;
+  }
+  out << YAML::EndSeq;
+  os << out.c_str() << "\n";
+}
+
+}  // namespace yaml
+}  // namespace cnr
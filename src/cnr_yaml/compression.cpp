@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <stdexcept>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_streambuf.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 107000
+#include <boost/iostreams/filter/zstd.hpp>
+#define CNR_YAML_HAS_ZSTD 1
+#endif
+
+#include <cnr_yaml/compression.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+std::string to_string(const Compression& compression)
+{
+  switch (compression)
+  {
+    case Compression::NONE:
+      return "none";
+    case Compression::GZIP:
+      return "gzip";
+    case Compression::BZIP2:
+      return "bzip2";
+    case Compression::ZSTD:
+      return "zstd";
+  }
+  return "unknown";
+}
+
+Compression compression_from_magic(std::string_view head)
+{
+  auto byte = [&head](std::size_t i) { return static_cast<unsigned char>(head[i]); };
+  if (head.size() >= 2 && byte(0) == 0x1f && byte(1) == 0x8b)
+  {
+    return Compression::GZIP;
+  }
+  // "BZh" and the block size, '1' to '9'
+  if (head.size() >= 4 && head.substr(0, 3) == "BZh" && head[3] >= '1' && head[3] <= '9')
+  {
+    return Compression::BZIP2;
+  }
+  if (head.size() >= 4 && byte(0) == 0x28 && byte(1) == 0xb5 && byte(2) == 0x2f && byte(3) == 0xfd)
+  {
+    return Compression::ZSTD;
+  }
+  return Compression::NONE;
+}
+
+Compression compression_from_extension(const std::string& path)
+{
+  auto ends_with = [&path](std::string_view ext) { return std::string_view(path).ends_with(ext); };
+  if (ends_with(".gz") || ends_with(".gzip"))
+  {
+    return Compression::GZIP;
+  }
+  if (ends_with(".bz2"))
+  {
+    return Compression::BZIP2;
+  }
+  if (ends_with(".zst") || ends_with(".zstd"))
+  {
+    return Compression::ZSTD;
+  }
+  return Compression::NONE;
+}
+
+Compression detect_compression(const std::string& path, std::string_view head)
+{
+  Compression ret = compression_from_magic(head);
+  return ret != Compression::NONE ? ret : compression_from_extension(path);
+}
+
+Compression detect_compression(const std::string& path, std::streambuf& source)
+{
+  char head[4];
+  std::streamsize n = source.sgetn(head, sizeof(head));
+  source.pubseekpos(0, std::ios::in);
+  return detect_compression(path, std::string_view(head, static_cast<std::size_t>(std::max<std::streamsize>(n, 0))));
+}
+
+bool is_supported(const Compression& compression)
+{
+#ifdef CNR_YAML_HAS_ZSTD
+  const bool zstd = true;
+#else
+  const bool zstd = false;
+#endif
+  return compression != Compression::ZSTD || zstd;
+}
+
+DecompressingStream::DecompressingStream(std::streambuf* source, const Compression& compression,
+                                         std::size_t buffer_size)
+  : std::istream(nullptr)
+{
+  if (compression == Compression::NONE)
+  {
+    rdbuf(source);
+    return;
+  }
+
+  auto buffer = std::make_unique<boost::iostreams::filtering_istreambuf>();
+  switch (compression)
+  {
+    case Compression::GZIP:
+      buffer->push(boost::iostreams::gzip_decompressor(), buffer_size);
+      break;
+    case Compression::BZIP2:
+      buffer->push(boost::iostreams::bzip2_decompressor(), buffer_size);
+      break;
+    case Compression::ZSTD:
+#ifdef CNR_YAML_HAS_ZSTD
+      buffer->push(boost::iostreams::zstd_decompressor(), buffer_size);
+      break;
+#else
+      throw std::runtime_error("The zstd decompression is not supported (it requires Boost 1.70)");
+#endif
+    case Compression::NONE:
+      break;
+  }
+  buffer->push(*source, buffer_size);
+  buffer_ = std::move(buffer);
+  rdbuf(buffer_.get());
+  exceptions(std::ios::badbit);
+}
+
+DecompressingStream::~DecompressingStream() = default;
+
+}  // namespace yaml
+}  // namespace cnr
@@ -0,0 +1,140 @@
+#include <fstream>
+#include <sstream>
+#include <yaml-cpp/eventhandler.h>
+#include <yaml-cpp/parser.h>
+
+#include <cnr_yaml/document.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+namespace
+{
+/**
+ * @brief It forwards the events of the YAML::Parser to the frozen::Builder
+ */
+class FrozenEventHandler : public YAML::EventHandler
+{
+public:
+  explicit FrozenEventHandler(frozen::Builder& builder) : builder_(builder)
+  {
+  }
+
+  void OnDocumentStart(const YAML::Mark& mark) override
+  {
+    mark_ = mark;
+  }
+  void OnDocumentEnd() override
+  {
+  }
+  void OnNull(const YAML::Mark& mark, YAML::anchor_t anchor) override
+  {
+    mark_ = mark;
+    builder_.null();
+    set_anchor(anchor);
+  }
+  void OnAlias(const YAML::Mark& mark, YAML::anchor_t anchor) override
+  {
+    mark_ = mark;
+    builder_.alias(anchor);
+  }
+  void OnScalar(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor,
+                const std::string& value) override
+  {
+    mark_ = mark;
+    builder_.scalar(value, tag);
+    set_anchor(anchor);
+  }
+  void OnSequenceStart(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor,
+                       YAML::EmitterStyle::value style) override
+  {
+    mark_ = mark;
+    builder_.begin_sequence(tag, style == YAML::EmitterStyle::Flow);
+    set_anchor(anchor);
+  }
+  void OnSequenceEnd() override
+  {
+    builder_.end();
+  }
+  void OnMapStart(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor,
+                  YAML::EmitterStyle::value style) override
+  {
+    mark_ = mark;
+    builder_.begin_map(tag, style == YAML::EmitterStyle::Flow);
+    set_anchor(anchor);
+  }
+  void OnMapEnd() override
+  {
+    builder_.end();
+  }
+
+  const YAML::Mark& mark() const
+  {
+    return mark_;
+  }
+
+private:
+  void set_anchor(YAML::anchor_t anchor)
+  {
+    if (anchor != YAML::NullAnchor)
+    {
+      builder_.anchor(anchor);
+    }
+  }
+
+  frozen::Builder& builder_;
+  YAML::Mark mark_;
+};
+
+}  // namespace
+
+bool Document::parse(std::istream& input, std::string& what)
+{
+  frozen::Builder builder;
+  FrozenEventHandler handler(builder);
+  try
+  {
+    YAML::Parser parser(input);
+    parser.HandleNextDocument(handler);
+    root_ = FrozenNode(builder.finish());
+  }
+  catch (const YAML::Exception& e)
+  {
+    what = e.what();
+    return false;
+  }
+  catch (const std::exception& e)
+  {
+    what = "yaml-cpp: error at line " + std::to_string(handler.mark().line + 1) + ", column " +
+           std::to_string(handler.mark().column + 1) + ": " + e.what();
+    return false;
+  }
+  return true;
+}
+
+bool Document::parse(const std::string& input, std::string& what)
+{
+  std::stringstream stream(input);
+  return parse(stream, what);
+}
+
+bool Document::parse_file(const std::string& path, std::string& what)
+{
+  std::ifstream input(path);
+  if (!input)
+  {
+    what = "Could not open the file '" + path + "'";
+    return false;
+  }
+  if (!parse(input, what))
+  {
+    what = "'" + path + "': " + what;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace yaml
+}  // namespace cnr
@@ -0,0 +1,956 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <cnr_yaml/string.h>
+#include <cnr_yaml/frozen_node.h>
+#include <cnr_yaml/access_profile.h>
+
+namespace cnr
+{
+namespace yaml
+{
+namespace frozen
+{
+
+namespace
+{
+constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+std::size_t align8(std::size_t v)
+{
+  return (v + 7) & ~static_cast<std::size_t>(7);
+}
+
+std::uint32_t checked_u32(std::size_t v, const char* what)
+{
+  if (v >= NONE)
+  {
+    throw std::runtime_error(std::string("The frozen tree is too big: too many ") + what);
+  }
+  return static_cast<std::uint32_t>(v);
+}
+
+std::string_view trim_right(std::string_view s)
+{
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\n' || s.back() == '\r'))
+  {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+// same as YAML::convert<bool>: y/n, yes/no, true/false, on/off, all lower, all upper or capitalized
+bool is_flexible_case(std::string_view s)
+{
+  auto is_lower = [](char c) { return c >= 'a' && c <= 'z'; };
+  auto is_upper = [](char c) { return c >= 'A' && c <= 'Z'; };
+  if (s.empty() || std::all_of(s.begin(), s.end(), is_lower))
+  {
+    return true;
+  }
+  std::string_view rest = s.substr(1);
+  return is_upper(s.front()) && (std::all_of(rest.begin(), rest.end(), is_lower) ||
+                                 std::all_of(rest.begin(), rest.end(), is_upper));
+}
+
+bool parse_bool(std::string_view s, bool& v)
+{
+  if (s.empty() || s.size() > 5 || !is_flexible_case(s))
+  {
+    return false;
+  }
+  char lower[6] = { 0 };
+  for (std::size_t i = 0; i < s.size() && i < sizeof(lower) - 1; i++)
+  {
+    lower[i] = (s[i] >= 'A' && s[i] <= 'Z') ? char(s[i] - 'A' + 'a') : s[i];
+  }
+  std::string_view l(lower, s.size());
+  if (l == "y" || l == "yes" || l == "true" || l == "on")
+  {
+    v = true;
+    return true;
+  }
+  if (l == "n" || l == "no" || l == "false" || l == "off")
+  {
+    v = false;
+    return true;
+  }
+  return false;
+}
+
+// same as the stream extraction used by YAML::convert<int>: base detected from the prefix (0x, 0)
+bool parse_integer(std::string_view s, std::int64_t& v)
+{
+  s = trim_right(s);
+  if (s.empty())
+  {
+    return false;
+  }
+  bool negative = false;
+  if (s.front() == '+' || s.front() == '-')
+  {
+    negative = s.front() == '-';
+    s.remove_prefix(1);
+  }
+  int base = 10;
+  if (s.size() > 1 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X'))
+  {
+    base = 16;
+    s.remove_prefix(2);
+  }
+  else if (s.size() > 1 && s[0] == '0')
+  {
+    base = 8;
+    s.remove_prefix(1);
+  }
+  if (s.empty())
+  {
+    return false;
+  }
+  std::uint64_t u = 0;
+  auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), u, base);
+  if (ec != std::errc() || ptr != s.data() + s.size())
+  {
+    return false;
+  }
+  constexpr std::uint64_t max = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+  if (negative)
+  {
+    if (u > max + 1)
+    {
+      return false;
+    }
+    v = (u == max + 1) ? std::numeric_limits<std::int64_t>::min() : -static_cast<std::int64_t>(u);
+  }
+  else
+  {
+    if (u > max)
+    {
+      return false;
+    }
+    v = static_cast<std::int64_t>(u);
+  }
+  return true;
+}
+
+// same as YAML::convert<double>: decimal notation, or .inf/.nan
+bool parse_double(std::string_view s, double& v)
+{
+  s = trim_right(s);
+  if (s == ".inf" || s == ".Inf" || s == ".INF" || s == "+.inf" || s == "+.Inf" || s == "+.INF")
+  {
+    v = std::numeric_limits<double>::infinity();
+    return true;
+  }
+  if (s == "-.inf" || s == "-.Inf" || s == "-.INF")
+  {
+    v = -std::numeric_limits<double>::infinity();
+    return true;
+  }
+  if (s == ".nan" || s == ".NaN" || s == ".NAN")
+  {
+    v = std::numeric_limits<double>::quiet_NaN();
+    return true;
+  }
+  if (!s.empty() && s.front() == '+')
+  {
+    s.remove_prefix(1);
+  }
+  if (s.empty() || std::any_of(s.begin(), s.end(), [](char c) {
+        return !((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '-' || c == '+');
+      }))
+  {
+    return false;
+  }
+  auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+  return ec == std::errc() && ptr == s.data() + s.size();
+}
+
+const Entry* lookup(const Image& image, const Entry* entry, std::string_view key, std::uint64_t key_hash)
+{
+  if (entry->type != YAML::NodeType::Map)
+  {
+    return nullptr;
+  }
+  const Entry* first = image.entries() + entry->data;
+  const std::uint32_t* begin = image.indexes() + entry->table;
+  const std::uint32_t* end = begin + entry->size;
+  const std::uint32_t* it = std::lower_bound(
+      begin, end, key_hash, [first](const std::uint32_t& i, const std::uint64_t& h) { return first[i].key_hash < h; });
+  for (; it != end && first[*it].key_hash == key_hash; ++it)
+  {
+    if (image.string(first[*it].key, first[*it].key_size) == key)
+    {
+      return first + *it;
+    }
+  }
+  return nullptr;
+}
+
+YAML::Node to_node(const Image& image, const Entry* entry)
+{
+  YAML::Node ret;
+  switch (entry->type)
+  {
+    case YAML::NodeType::Scalar:
+      ret = YAML::Node(std::string(image.string(entry->data, entry->size)));
+      break;
+    case YAML::NodeType::Sequence:
+      ret = YAML::Node(YAML::NodeType::Sequence);
+      for (std::uint32_t i = 0; i < entry->size; i++)
+      {
+        ret.push_back(to_node(image, image.entries() + entry->data + i));
+      }
+      break;
+    case YAML::NodeType::Map:
+      ret = YAML::Node(YAML::NodeType::Map);
+      for (std::uint32_t i = 0; i < entry->size; i++)
+      {
+        const Entry* child = image.entries() + entry->data + i;
+        // no lookup (operator[] is a linear scan): the keys of the frozen map are already the ones of a map
+        ret.force_insert(std::string(image.string(child->key, child->key_size)), to_node(image, child));
+      }
+      break;
+    default:
+      ret = YAML::Node(YAML::NodeType::Null);
+      break;
+  }
+  if (entry->flags & FLOW_STYLE)
+  {
+    ret.SetStyle(YAML::EmitterStyle::Flow);
+  }
+  if (entry->tag_size)
+  {
+    ret.SetTag(std::string(image.string(entry->tag, entry->tag_size)));
+  }
+  return ret;
+}
+
+}  // namespace
+
+std::uint8_t parse_scalar(std::string_view value, std::int64_t& as_integer, double& as_double)
+{
+  std::uint8_t flags = 0;
+  bool b = false;
+  if (parse_bool(value, b))
+  {
+    flags |= IS_BOOL | (b ? BOOL_VALUE : 0);
+  }
+  if (parse_integer(value, as_integer))
+  {
+    flags |= IS_INTEGER;
+  }
+  if (parse_double(value, as_double))
+  {
+    flags |= IS_DOUBLE;
+  }
+  return flags;
+}
+
+bool validate(const Image& image, std::string& what)
+{
+  const Header& h = image.header();
+  auto in = [](std::uint64_t offset, std::uint64_t size, std::uint64_t max) { return offset + size <= max; };
+  // the layout is breadth-first: the children follow their parent, so that a child cannot point back to an ancestor
+  for (std::uint64_t i = 0; i < h.entries; i++)
+  {
+    const Entry& e = image.entries()[i];
+    bool ok = in(e.key, e.key_size, h.strings_size) && in(e.tag, e.tag_size, h.strings_size);
+    switch (e.type)
+    {
+      case YAML::NodeType::Scalar:
+        ok = ok && in(e.data, e.size, h.strings_size);
+        break;
+      case YAML::NodeType::Sequence:
+        ok = ok && in(e.data, e.size, h.entries) && (e.size == 0 || e.data > i);
+        if (e.flags & (NUMERIC_ARRAY | NUMERIC_MATRIX))
+        {
+          ok = ok && in(e.table, std::uint64_t(e.size) * e.cols, h.numbers);
+        }
+        break;
+      case YAML::NodeType::Map:
+        ok = ok && in(e.data, e.size, h.entries) && (e.size == 0 || e.data > i) && in(e.table, e.size, h.indexes);
+        for (std::uint32_t k = 0; ok && k < e.size; k++)
+        {
+          ok = image.indexes()[e.table + k] < e.size;
+        }
+        break;
+      case YAML::NodeType::Null:
+        break;
+      default:
+        ok = false;
+        break;
+    }
+    if (!ok)
+    {
+      what = "The frozen YAML tree is corrupted (entry #" + std::to_string(i) + ")";
+      return false;
+    }
+  }
+  return true;
+}
+
+// =====================================================================================================================
+// Image
+// =====================================================================================================================
+Image::Image(std::shared_ptr<const void> owner, const void* data, std::size_t size)
+  : owner_(std::move(owner)), size_(size), header_(static_cast<const Header*>(data))
+{
+  if (!data || size < sizeof(Header))
+  {
+    throw std::runtime_error("The blob is too small to be a frozen YAML tree");
+  }
+  if ((reinterpret_cast<std::uintptr_t>(data) % 8) != 0)
+  {
+    throw std::runtime_error("The frozen blob is not aligned to 8 bytes");
+  }
+  if (std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0)
+  {
+    throw std::runtime_error("The blob is not a frozen YAML tree (wrong magic number)");
+  }
+  if (header_->version != VERSION || header_->entry_size != sizeof(Entry))
+  {
+    throw std::runtime_error("The frozen YAML tree has version " + std::to_string(header_->version) +
+                             ", while the supported version is " + std::to_string(VERSION));
+  }
+  const Header& h = *header_;
+  // the sections are in order, and the counts are compared with the room of their section: a sum or a product of
+  // the (untrusted) fields could wrap around
+  bool ok = h.size <= size && h.entries > 0 && (h.entries_offset % 8) == 0 && (h.numbers_offset % 8) == 0 &&
+            (h.indexes_offset % 4) == 0 && sizeof(Header) <= h.entries_offset && h.entries_offset <= h.numbers_offset &&
+            h.numbers_offset <= h.indexes_offset && h.indexes_offset <= h.strings_offset &&
+            h.strings_offset <= h.size && h.entries <= (h.numbers_offset - h.entries_offset) / sizeof(Entry) &&
+            h.numbers <= (h.indexes_offset - h.numbers_offset) / sizeof(double) &&
+            h.indexes <= (h.strings_offset - h.indexes_offset) / sizeof(std::uint32_t) &&
+            h.strings_size <= h.size - h.strings_offset;
+  if (!ok)
+  {
+    throw std::runtime_error("The frozen YAML tree is corrupted (inconsistent header)");
+  }
+  const char* base = static_cast<const char*>(data);
+  entries_ = reinterpret_cast<const Entry*>(base + h.entries_offset);
+  numbers_ = reinterpret_cast<const double*>(base + h.numbers_offset);
+  indexes_ = reinterpret_cast<const std::uint32_t*>(base + h.indexes_offset);
+  strings_ = base + h.strings_offset;
+}
+
+// =====================================================================================================================
+// Builder
+// =====================================================================================================================
+Builder::Builder()
+{
+  intern("");
+}
+
+std::uint32_t Builder::intern(std::string_view str)
+{
+  const std::uint64_t hash = fnv1a(str);
+  auto range = interned_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second.second == str.size() && std::string_view(strings_).substr(it->second.first, str.size()) == str)
+    {
+      return it->second.first;
+    }
+  }
+  const std::uint32_t offset = checked_u32(strings_.size() + str.size(), "characters") - str.size();
+  strings_.append(str);
+  interned_.emplace(hash, std::make_pair(offset, static_cast<std::uint32_t>(str.size())));
+  return offset;
+}
+
+bool Builder::key_expected() const
+{
+  return !stack_.empty() && nodes_[stack_.back()].type == YAML::NodeType::Map && !key_pending_;
+}
+
+void Builder::set_key(std::uint32_t offset, std::uint32_t size)
+{
+  pending_key_ = offset;
+  pending_key_size_ = size;
+  pending_key_hash_ = fnv1a(std::string_view(strings_).substr(offset, size));
+  key_pending_ = true;
+  last_is_key_ = true;
+}
+
+Builder::Node& Builder::push(std::uint8_t type, std::string_view tag)
+{
+  if (stack_.empty() && !nodes_.empty())
+  {
+    throw std::runtime_error("The frozen tree must have a single root");
+  }
+  Node n;
+  n.type = type;
+  n.tag = intern(tag);
+  n.tag_size = static_cast<std::uint32_t>(tag.size());
+  n.parent = stack_.empty() ? NONE : stack_.back();
+  n.end = checked_u32(nodes_.size() + 1, "nodes");
+  if (!stack_.empty() && nodes_[stack_.back()].type == YAML::NodeType::Map)
+  {
+    n.key = pending_key_;
+    n.key_size = pending_key_size_;
+    n.key_hash = pending_key_hash_;
+    key_pending_ = false;
+  }
+  last_is_key_ = false;
+  nodes_.push_back(n);
+  return nodes_.back();
+}
+
+void Builder::null(std::string_view tag)
+{
+  if (key_expected())
+  {
+    // as the text of a null YAML::Node
+    scalar("~", "");
+    return;
+  }
+  push(YAML::NodeType::Null, tag);
+}
+
+void Builder::scalar(std::string_view value, std::string_view tag)
+{
+  if (key_expected())
+  {
+    set_key(intern(value), static_cast<std::uint32_t>(value.size()));
+    return;
+  }
+  std::int64_t as_integer = 0;
+  double as_double = 0.0;
+  std::uint8_t flags = parse_scalar(value, as_integer, as_double);
+  std::uint32_t offset = intern(value);
+  Node& n = push(YAML::NodeType::Scalar, tag);
+  n.value = offset;
+  n.value_size = static_cast<std::uint32_t>(value.size());
+  n.flags = flags;
+  n.as_integer = as_integer;
+  n.as_double = as_double;
+}
+
+void Builder::begin_sequence(std::string_view tag, bool flow)
+{
+  if (key_expected())
+  {
+    throw std::runtime_error("The frozen tree does not support keys that are not scalars");
+  }
+  Node& n = push(YAML::NodeType::Sequence, tag);
+  n.flags = flow ? FLOW_STYLE : 0;
+  n.end = NONE;
+  stack_.push_back(static_cast<std::uint32_t>(nodes_.size() - 1));
+}
+
+void Builder::begin_map(std::string_view tag, bool flow)
+{
+  if (key_expected())
+  {
+    throw std::runtime_error("The frozen tree does not support keys that are not scalars");
+  }
+  Node& n = push(YAML::NodeType::Map, tag);
+  n.flags = flow ? FLOW_STYLE : 0;
+  n.end = NONE;
+  stack_.push_back(static_cast<std::uint32_t>(nodes_.size() - 1));
+}
+
+void Builder::end()
+{
+  if (stack_.empty())
+  {
+    throw std::runtime_error("Unbalanced end of a sequence or of a map");
+  }
+  nodes_[stack_.back()].end = static_cast<std::uint32_t>(nodes_.size());
+  stack_.pop_back();
+  key_pending_ = false;
+  last_is_key_ = false;
+}
+
+void Builder::anchor(std::uint64_t id)
+{
+  Anchor a;
+  if (last_is_key_)
+  {
+    a.is_key = true;
+    a.key = pending_key_;
+    a.key_size = pending_key_size_;
+  }
+  else if (!nodes_.empty())
+  {
+    a.node = static_cast<std::uint32_t>(nodes_.size() - 1);
+  }
+  else
+  {
+    throw std::runtime_error("No node to be anchored");
+  }
+  anchors_[id] = a;
+}
+
+void Builder::alias(std::uint64_t id)
+{
+  auto it = anchors_.find(id);
+  if (it == anchors_.end())
+  {
+    throw std::runtime_error("Alias to an unknown anchor");
+  }
+  const Anchor a = it->second;
+  if (a.is_key)
+  {
+    const std::string value(std::string_view(strings_).substr(a.key, a.key_size));
+    scalar(value, "");
+    return;
+  }
+
+  const Node src = nodes_[a.node];
+  if (src.end == NONE)
+  {
+    throw std::runtime_error("Recursive aliases are not supported by the frozen tree");
+  }
+  if (key_expected())
+  {
+    if (src.type == YAML::NodeType::Scalar)
+    {
+      set_key(src.value, src.value_size);
+    }
+    else if (src.type == YAML::NodeType::Null)
+    {
+      scalar("~", "");
+    }
+    else
+    {
+      throw std::runtime_error("The frozen tree does not support keys that are not scalars");
+    }
+    return;
+  }
+
+  // the subtree is contiguous in depth-first order: it is copied, and the parents are shifted
+  const std::uint32_t base = static_cast<std::uint32_t>(nodes_.size());
+  checked_u32(nodes_.size() + (src.end - a.node), "nodes");
+  Node& root = push(src.type, "");
+  Node copy = src;
+  copy.key = root.key;
+  copy.key_size = root.key_size;
+  copy.key_hash = root.key_hash;
+  copy.parent = root.parent;
+  copy.end = base + (src.end - a.node);
+  root = copy;
+  for (std::uint32_t i = a.node + 1; i < src.end; i++)
+  {
+    Node n = nodes_[i];
+    n.parent = n.parent - a.node + base;
+    n.end = n.end - a.node + base;
+    nodes_.push_back(n);
+  }
+}
+
+void Builder::reset()
+{
+  // the containers give back their storage (a no-op for the arena), and then the arena is released at once
+  decltype(nodes_)(&arena_).swap(nodes_);
+  decltype(stack_)(&arena_).swap(stack_);
+  decltype(strings_)(&arena_).swap(strings_);
+  decltype(interned_)(&arena_).swap(interned_);
+  decltype(anchors_)(&arena_).swap(anchors_);
+  arena_.release();
+  key_pending_ = false;
+  last_is_key_ = false;
+  intern("");
+}
+
+void Builder::add(const YAML::Node& node)
+{
+  switch (node.Type())
+  {
+    case YAML::NodeType::Scalar:
+      scalar(node.Scalar(), node.Tag());
+      break;
+    case YAML::NodeType::Sequence:
+      begin_sequence(node.Tag(), node.Style() == YAML::EmitterStyle::Flow);
+      for (const auto& item : node)
+      {
+        add(item);
+      }
+      end();
+      break;
+    case YAML::NodeType::Map:
+      begin_map(node.Tag(), node.Style() == YAML::EmitterStyle::Flow);
+      for (const auto& kv : node)
+      {
+        // the keys that are not scalars are stored as their YAML text
+        scalar(kv.first.IsScalar() ? kv.first.Scalar() : std::to_string(kv.first));
+        add(kv.second);
+      }
+      end();
+      break;
+    default:
+      null(node.IsDefined() ? node.Tag() : "");
+      break;
+  }
+}
+
+std::shared_ptr<const Image> Builder::finish()
+{
+  if (!stack_.empty())
+  {
+    throw std::runtime_error("The frozen tree has an unterminated sequence or map");
+  }
+  if (nodes_.empty())
+  {
+    push(YAML::NodeType::Null, "");
+  }
+  const std::size_t n = nodes_.size();
+
+  // children of each node, in the input order (counting sort over the parent index)
+  std::pmr::vector<std::uint32_t> first(n + 1, 0, &arena_);
+  for (std::size_t i = 1; i < n; i++)
+  {
+    first[nodes_[i].parent + 1]++;
+  }
+  for (std::size_t i = 0; i < n; i++)
+  {
+    first[i + 1] += first[i];
+  }
+  std::pmr::vector<std::uint32_t> children(n > 0 ? n - 1 : 0, &arena_);
+  {
+    std::pmr::vector<std::uint32_t> fill(first.begin(), first.end() - 1, &arena_);
+    for (std::size_t i = 1; i < n; i++)
+    {
+      children[fill[nodes_[i].parent]++] = static_cast<std::uint32_t>(i);
+    }
+  }
+
+  // breadth-first layout: the children of a node are contiguous
+  std::pmr::vector<std::uint32_t> order(n, &arena_);
+  std::pmr::vector<std::uint32_t> position(n, &arena_);
+  order[0] = 0;
+  std::size_t next = 1;
+  for (std::size_t out = 0; out < n; out++)
+  {
+    const std::uint32_t u = order[out];
+    position[u] = static_cast<std::uint32_t>(out);
+    for (std::uint32_t c = first[u]; c < first[u + 1]; c++)
+    {
+      order[next++] = children[c];
+    }
+  }
+
+  std::pmr::vector<Entry> entries(n, &arena_);
+  std::pmr::vector<std::uint32_t> indexes(&arena_);
+  for (std::size_t out = 0; out < n; out++)
+  {
+    const Node& src = nodes_[order[out]];
+    Entry& e = entries[out];
+    std::memset(&e, 0, sizeof(Entry));
+    e.key_hash = src.key_hash;
+    e.key = src.key;
+    e.key_size = src.key_size;
+    e.tag = src.tag;
+    e.tag_size = src.tag_size;
+    e.type = src.type;
+    e.flags = src.flags;
+    e.as_integer = src.as_integer;
+    e.as_double = src.as_double;
+    if (src.type == YAML::NodeType::Scalar)
+    {
+      e.data = src.value;
+      e.size = src.value_size;
+    }
+    else if (src.type == YAML::NodeType::Sequence || src.type == YAML::NodeType::Map)
+    {
+      const std::uint32_t u = order[out];
+      e.size = first[u + 1] - first[u];
+      e.data = e.size ? position[children[first[u]]] : 0;
+    }
+  }
+
+  // lookup tables of the maps, sorted by key hash (stable, so that the first duplicated key wins as in yaml-cpp)
+  for (std::size_t out = 0; out < n; out++)
+  {
+    Entry& e = entries[out];
+    if (e.type != YAML::NodeType::Map)
+    {
+      continue;
+    }
+    e.table = checked_u32(indexes.size(), "keys");
+    const std::size_t begin = indexes.size();
+    for (std::uint32_t i = 0; i < e.size; i++)
+    {
+      indexes.push_back(i);
+    }
+    const Entry* items = entries.data() + e.data;
+    std::stable_sort(indexes.begin() + begin, indexes.end(), [items](const std::uint32_t& a, const std::uint32_t& b) {
+      return items[a].key_hash < items[b].key_hash;
+    });
+  }
+
+  // numeric sequences: the children are visited before the parents to classify vectors and matrices
+  for (std::size_t out = n; out-- > 0;)
+  {
+    Entry& e = entries[out];
+    if (e.type != YAML::NodeType::Sequence || e.size == 0)
+    {
+      continue;
+    }
+    const Entry* items = entries.data() + e.data;
+    if (std::all_of(items, items + e.size, [](const Entry& i) {
+          return i.type == YAML::NodeType::Scalar && (i.flags & IS_DOUBLE);
+        }))
+    {
+      e.flags |= NUMERIC_ARRAY;
+      e.cols = 1;
+    }
+    else if (std::all_of(items, items + e.size, [items](const Entry& i) {
+               return (i.flags & NUMERIC_ARRAY) && i.size == items[0].size;
+             }))
+    {
+      e.flags |= NUMERIC_MATRIX;
+      e.cols = items[0].size;
+    }
+  }
+
+  // flatten the numbers: the rows of a matrix are slices of the matrix storage
+  std::pmr::vector<double> numbers(&arena_);
+  std::pmr::vector<bool> assigned(n, false, &arena_);
+  for (std::size_t out = 0; out < n; out++)
+  {
+    Entry& e = entries[out];
+    if (e.flags & NUMERIC_MATRIX)
+    {
+      e.table = checked_u32(numbers.size(), "numbers");
+      for (std::uint32_t r = 0; r < e.size; r++)
+      {
+        Entry& row = entries[e.data + r];
+        row.table = checked_u32(numbers.size(), "numbers");
+        assigned[e.data + r] = true;
+        for (std::uint32_t c = 0; c < row.size; c++)
+        {
+          numbers.push_back(entries[row.data + c].as_double);
+        }
+      }
+    }
+    else if ((e.flags & NUMERIC_ARRAY) && !assigned[out])
+    {
+      e.table = checked_u32(numbers.size(), "numbers");
+      for (std::uint32_t c = 0; c < e.size; c++)
+      {
+        numbers.push_back(entries[e.data + c].as_double);
+      }
+    }
+  }
+
+  // the blob
+  Header h;
+  std::memset(&h, 0, sizeof(Header));
+  std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+  h.version = VERSION;
+  h.entry_size = sizeof(Entry);
+  h.entries_offset = align8(sizeof(Header));
+  h.entries = n;
+  h.numbers_offset = h.entries_offset + n * sizeof(Entry);
+  h.numbers = numbers.size();
+  h.indexes_offset = h.numbers_offset + numbers.size() * sizeof(double);
+  h.indexes = indexes.size();
+  h.strings_offset = h.indexes_offset + indexes.size() * sizeof(std::uint32_t);
+  h.strings_size = strings_.size();
+  h.size = h.strings_offset + strings_.size();
+
+  const std::size_t words = align8(h.size) / 8;
+  std::shared_ptr<std::uint64_t> buffer(new std::uint64_t[words](), std::default_delete<std::uint64_t[]>());
+  char* base = reinterpret_cast<char*>(buffer.get());
+  std::memcpy(base, &h, sizeof(Header));
+  std::memcpy(base + h.entries_offset, entries.data(), n * sizeof(Entry));
+  if (!numbers.empty())
+  {
+    std::memcpy(base + h.numbers_offset, numbers.data(), numbers.size() * sizeof(double));
+  }
+  if (!indexes.empty())
+  {
+    std::memcpy(base + h.indexes_offset, indexes.data(), indexes.size() * sizeof(std::uint32_t));
+  }
+  std::memcpy(base + h.strings_offset, strings_.data(), strings_.size());
+
+  reset();
+
+  return std::make_shared<const Image>(buffer, buffer.get(), static_cast<std::size_t>(h.size));
+}
+
+}  // namespace frozen
+
+// =====================================================================================================================
+// FrozenNode
+// =====================================================================================================================
+FrozenNode::FrozenNode(const YAML::Node& node)
+{
+  frozen::Builder builder;
+  builder.add(node);
+  image_ = builder.finish();
+  entry_ = image_->entries();
+}
+
+FrozenNode::FrozenNode(std::shared_ptr<const frozen::Image> image)
+  : image_(std::move(image)), entry_(image_ ? image_->entries() : nullptr)
+{
+}
+
+FrozenNode::FrozenNode(std::shared_ptr<const frozen::Image> image, const frozen::Entry* entry)
+  : image_(std::move(image)), entry_(entry)
+{
+}
+
+YAML::NodeType::value FrozenNode::Type() const
+{
+  return entry_ ? static_cast<YAML::NodeType::value>(entry_->type) : YAML::NodeType::Undefined;
+}
+
+std::size_t FrozenNode::size() const
+{
+  return (IsSequence() || IsMap()) ? entry_->size : 0;
+}
+
+std::string_view FrozenNode::Scalar() const
+{
+  return IsScalar() ? image_->string(entry_->data, entry_->size) : std::string_view();
+}
+
+std::string_view FrozenNode::Tag() const
+{
+  return entry_ ? image_->string(entry_->tag, entry_->tag_size) : std::string_view();
+}
+
+std::string_view FrozenNode::key() const
+{
+  return entry_ ? image_->string(entry_->key, entry_->key_size) : std::string_view();
+}
+
+FrozenNode FrozenNode::operator[](std::string_view key) const
+{
+  return find(key, fnv1a(key));
+}
+
+FrozenNode FrozenNode::find(std::string_view key, std::uint64_t key_hash) const
+{
+  if (!entry_)
+  {
+    return FrozenNode();
+  }
+  const frozen::Entry* e = frozen::lookup(*image_, entry_, key, key_hash);
+  return e ? FrozenNode(image_, e) : FrozenNode();
+}
+
+FrozenNode FrozenNode::operator[](std::size_t index) const
+{
+  if (!IsSequence() || index >= entry_->size)
+  {
+    return FrozenNode();
+  }
+  return FrozenNode(image_, image_->entries() + entry_->data + index);
+}
+
+FrozenNode::const_iterator FrozenNode::begin() const
+{
+  if (!IsSequence() && !IsMap())
+  {
+    return const_iterator();
+  }
+  return const_iterator(image_, image_->entries() + entry_->data);
+}
+
+FrozenNode::const_iterator FrozenNode::end() const
+{
+  if (!IsSequence() && !IsMap())
+  {
+    return const_iterator();
+  }
+  return const_iterator(image_, image_->entries() + entry_->data + entry_->size);
+}
+
+std::span<const double> FrozenNode::numbers() const
+{
+  if (!IsSequence() || !(entry_->flags & (frozen::NUMERIC_ARRAY | frozen::NUMERIC_MATRIX)))
+  {
+    return std::span<const double>();
+  }
+  return std::span<const double>(image_->numbers() + entry_->table, std::size_t(entry_->size) * entry_->cols);
+}
+
+YAML::Node FrozenNode::to_node() const
+{
+  return entry_ ? frozen::to_node(*image_, entry_) : YAML::Node();
+}
+
+std::size_t FrozenNode::memory_usage() const
+{
+  return image_ ? image_->bytes() : 0;
+}
+
+Eigen::Map<const Eigen::VectorXd> as_eigen_vector(const FrozenNode& node)
+{
+  if (!node.IsSequence() || !(node.entry()->flags & frozen::NUMERIC_ARRAY))
+  {
+    return Eigen::Map<const Eigen::VectorXd>(nullptr, 0);
+  }
+  auto n = node.numbers();
+  return Eigen::Map<const Eigen::VectorXd>(n.data(), static_cast<Eigen::Index>(n.size()));
+}
+
+Eigen::Map<const RowMajorMatrixXd> as_eigen_matrix(const FrozenNode& node)
+{
+  auto n = node.numbers();
+  if (n.empty())
+  {
+    return Eigen::Map<const RowMajorMatrixXd>(nullptr, 0, 0);
+  }
+  const Eigen::Index rows = static_cast<Eigen::Index>(node.size());
+  return Eigen::Map<const RowMajorMatrixXd>(n.data(), rows, static_cast<Eigen::Index>(n.size()) / rows);
+}
+
+namespace
+{
+bool get_leaf_impl(const FrozenNode& node, const std::string& key, FrozenNode& leaf, std::string& what,
+                   const std::string& delimeters)
+{
+  if (!node)
+  {
+    what = "The key '" + key + "' cannot be resolved in an undefined frozen node";
+    return false;
+  }
+  const frozen::Entry* e = node.entry();
+  std::size_t pos = 0;
+  while (pos < key.size() || pos == 0)
+  {
+    std::size_t p = key.find_first_of(delimeters, pos);
+    std::string_view token(key.data() + pos, (p == std::string::npos ? key.size() : p) - pos);
+    const frozen::Entry* child = frozen::lookup(*node.image(), e, token, fnv1a(token));
+    if (!child)
+    {
+      what = "The key '" + key + "' has been resolved in the token '" + std::string(token) +
+             "' that is not in the node dictionary (Input Node: " +
+             std::to_string(FrozenNode(node.image(), e).to_node()) + ")";
+      return false;
+    }
+    e = child;
+    if (p == std::string::npos)
+    {
+      break;
+    }
+    pos = p + 1;
+  }
+  leaf = FrozenNode(node.image(), e);
+  return true;
+}
+}  // namespace
+
+bool get_leaf(const FrozenNode& node, const std::string& key, FrozenNode& leaf, std::string& what,
+              const std::string& delimeters)
+{
+  detail::AccessTimer timer;
+  const bool ok = get_leaf_impl(node, key, leaf, what, delimeters);
+  if (ok)
+  {
+    timer.record(key, std::string_view(), delimeters);
+  }
+  return ok;
+}
+
+}  // namespace yaml
+}  // namespace cnr
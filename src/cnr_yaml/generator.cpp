@@ -0,0 +1,357 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <unordered_set>
+
+#include <cnr_yaml/generator.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+namespace
+{
+
+/**
+ * @brief splitmix64: the std engines are portable, but the std distributions are not, so the draws are done here
+ */
+class Random
+{
+public:
+  explicit Random(std::uint64_t seed) : state_(seed)
+  {
+  }
+
+  std::uint64_t next()
+  {
+    std::uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  /**
+   * @brief An integer in [0, n)
+   */
+  std::size_t uniform(std::size_t n)
+  {
+    return n ? static_cast<std::size_t>(next() % n) : 0;
+  }
+
+  /**
+   * @brief A real in [0, 1), not rounded (the rounding of real() may reach the upper bound)
+   */
+  double unit()
+  {
+    return static_cast<double>(next() >> 11) * 0x1.0p-53;
+  }
+
+  /**
+   * @brief A real in [lo, hi), rounded to three decimals so that the text is short and stable
+   */
+  double real(double lo, double hi)
+  {
+    const double u = unit();
+    return std::round((lo + (hi - lo) * u) * 1000.0) / 1000.0;
+  }
+
+  std::string word(std::size_t length)
+  {
+    std::string ret(length, 'a');
+    for (auto& c : ret)
+    {
+      c = static_cast<char>('a' + uniform(26));
+    }
+    return ret;
+  }
+
+private:
+  std::uint64_t state_;
+};
+
+/**
+ * @brief A number as a plain scalar with its shortest text, since the emitter writes the doubles with all the digits
+ */
+YAML::Node number(double value)
+{
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+  return YAML::Node(std::string(buffer));
+}
+
+/**
+ * @brief The numeric arrays are written in the flow style, as in the hand-written configurations
+ */
+YAML::Node flow_sequence()
+{
+  YAML::Node node(YAML::NodeType::Sequence);
+  node.SetStyle(YAML::EmitterStyle::Flow);
+  return node;
+}
+
+class TreeGenerator
+{
+public:
+  explicit TreeGenerator(const GeneratorOptions& options) : options_(options), random_(options.seed)
+  {
+  }
+
+  YAML::Node map(std::size_t level)
+  {
+    nodes_++;
+    YAML::Node node(YAML::NodeType::Map);
+    std::unordered_set<std::string> used;
+    for (std::size_t i = 0; i < options_.breadth && !full(); i++)
+    {
+      std::string k = random_.word(std::max<std::size_t>(options_.key_length, 1));
+      if (!used.insert(k).second)
+      {
+        k += '_';
+        k += std::to_string(i);
+        used.insert(k);
+      }
+      // force_insert appends without searching the key, that is already known to be unique
+      node.force_insert(k, child(level));
+    }
+    return node;
+  }
+
+private:
+  bool full() const
+  {
+    return options_.max_nodes && nodes_ >= options_.max_nodes;
+  }
+
+  YAML::Node child(std::size_t level)
+  {
+    const double w_scalar = std::max(options_.scalar_weight, 0.0);
+    const double w_sequence = std::max(options_.sequence_weight, 0.0);
+    const double w_map = level + 1 < options_.depth ? std::max(options_.map_weight, 0.0) : 0.0;
+    const double total = w_scalar + w_sequence + w_map;
+    if (total <= 0.0)
+    {
+      return scalar();
+    }
+    const double u = random_.unit() * total;
+    if (u < w_scalar || (w_sequence <= 0.0 && w_map <= 0.0))
+    {
+      return scalar();
+    }
+    // the maps are never generated below the last level, even if the product rounds up to the total
+    if (u < w_scalar + w_sequence || w_map <= 0.0)
+    {
+      return array();
+    }
+    return map(level + 1);
+  }
+
+  YAML::Node scalar()
+  {
+    nodes_++;
+    switch (random_.uniform(4))
+    {
+      case 0:
+        return number(random_.real(-1000.0, 1000.0));
+      case 1:
+        return YAML::Node(static_cast<int>(random_.uniform(100000)) - 50000);
+      case 2:
+        return YAML::Node(random_.uniform(2) == 1);
+      default:
+        return YAML::Node(random_.word(std::max<std::size_t>(options_.key_length, 1)));
+    }
+  }
+
+  YAML::Node array()
+  {
+    const std::size_t lo = std::min(options_.min_array_size, options_.max_array_size);
+    const std::size_t hi = std::max(options_.min_array_size, options_.max_array_size);
+    const std::size_t size = lo + random_.uniform(hi - lo + 1);
+    YAML::Node node = flow_sequence();
+    for (std::size_t i = 0; i < size; i++)
+    {
+      node.push_back(number(random_.real(-10.0, 10.0)));
+    }
+    nodes_ += size + 1;
+    return node;
+  }
+
+  const GeneratorOptions& options_;
+  Random random_;
+  std::size_t nodes_ = 0;
+};
+
+YAML::Node array(Random& random, std::size_t size, double lo, double hi)
+{
+  YAML::Node node = flow_sequence();
+  for (std::size_t i = 0; i < size; i++)
+  {
+    node.push_back(number(random.real(lo, hi)));
+  }
+  return node;
+}
+
+const char* pick(Random& random, std::initializer_list<const char*> values)
+{
+  return *(values.begin() + random.uniform(values.size()));
+}
+
+YAML::Node arm(Random& random, const RobotCellOptions& options, const std::string& prefix)
+{
+  const std::size_t n = options.joints;
+  YAML::Node node(YAML::NodeType::Map);
+
+  YAML::Node joint_names = flow_sequence();
+  for (std::size_t j = 0; j < n; j++)
+  {
+    joint_names.push_back(prefix + "_joint_" + std::to_string(j));
+  }
+  node.force_insert("joint_names", joint_names);
+
+  YAML::Node limits(YAML::NodeType::Map);
+  YAML::Node position(YAML::NodeType::Map);
+  position.force_insert("min", array(random, n, -6.28, -1.0));
+  position.force_insert("max", array(random, n, 1.0, 6.28));
+  limits.force_insert("position", position);
+  limits.force_insert("velocity", array(random, n, 1.0, 4.0));
+  limits.force_insert("acceleration", array(random, n, 2.0, 20.0));
+  limits.force_insert("effort", array(random, n, 10.0, 300.0));
+  node.force_insert("limits", limits);
+
+  YAML::Node dh(YAML::NodeType::Sequence);
+  for (std::size_t j = 0; j < n; j++)
+  {
+    // a, alpha, d, theta
+    YAML::Node row = flow_sequence();
+    row.push_back(number(random.real(0.0, 0.6)));
+    row.push_back(pick(random, { "0.0", "1.5708", "-1.5708", "3.1416" }));
+    row.push_back(number(random.real(0.0, 0.4)));
+    row.push_back(number(0.0));
+    dh.push_back(row);
+  }
+  YAML::Node kinematics(YAML::NodeType::Map);
+  kinematics.force_insert("dh", dh);
+  node.force_insert("kinematics", kinematics);
+
+  YAML::Node tool(YAML::NodeType::Map);
+  tool.force_insert("name", pick(random, { "gripper", "screwdriver", "suction_cup", "camera_flange" }));
+  tool.force_insert("mass", number(random.real(0.2, 5.0)));
+  tool.force_insert("center_of_mass", array(random, 3, -0.05, 0.15));
+  YAML::Node inertia(YAML::NodeType::Sequence);
+  for (std::size_t r = 0; r < 3; r++)
+  {
+    YAML::Node row = flow_sequence();
+    for (std::size_t c = 0; c < 3; c++)
+    {
+      row.push_back(number(r == c ? random.real(0.001, 0.05) : 0.0));
+    }
+    inertia.push_back(row);
+  }
+  tool.force_insert("inertia", inertia);
+  node.force_insert("tool", tool);
+
+  YAML::Node controllers(YAML::NodeType::Map);
+  for (std::size_t c = 0; c < options.controllers_per_arm; c++)
+  {
+    YAML::Node controller(YAML::NodeType::Map);
+    controller.force_insert("type", pick(random, { "joint_position", "joint_velocity", "joint_impedance",
+                                                   "cartesian_impedance", "admittance" }));
+    controller.force_insert("rate", pick(random, { "250", "500", "1000" }));
+    controller.force_insert("enabled", c == 0);
+    YAML::Node gains(YAML::NodeType::Map);
+    gains.force_insert("p", array(random, n, 10.0, 1000.0));
+    gains.force_insert("i", array(random, n, 0.0, 10.0));
+    gains.force_insert("d", array(random, n, 1.0, 50.0));
+    controller.force_insert("gains", gains);
+    controllers.force_insert("controller_" + std::to_string(c), controller);
+  }
+  node.force_insert("controllers", controllers);
+  return node;
+}
+
+}  // namespace
+
+YAML::Node generate_tree(const GeneratorOptions& options)
+{
+  TreeGenerator generator(options);
+  return generator.map(0);
+}
+
+YAML::Node generate_robot_cell(const RobotCellOptions& options)
+{
+  Random random(options.seed);
+  YAML::Node cell(YAML::NodeType::Map);
+  cell.force_insert("name", "cell_" + std::to_string(options.seed));
+  cell.force_insert("frame", "world");
+
+  YAML::Node robots(YAML::NodeType::Map);
+  for (std::size_t r = 0; r < options.robots; r++)
+  {
+    const std::string name = "robot_" + std::to_string(r);
+    YAML::Node robot(YAML::NodeType::Map);
+    robot.force_insert("model", pick(random, { "ur10e", "lbr_iiwa_14", "irb_1200", "lr_mate_200id" }));
+
+    YAML::Node base(YAML::NodeType::Map);
+    base.force_insert("position", array(random, 3, -3.0, 3.0));
+    const double yaw = random.real(-3.1416, 3.1416);
+    YAML::Node orientation = flow_sequence();
+    orientation.push_back(number(0.0));
+    orientation.push_back(number(0.0));
+    orientation.push_back(number(std::round(std::sin(yaw / 2) * 1e6) / 1e6));
+    orientation.push_back(number(std::round(std::cos(yaw / 2) * 1e6) / 1e6));
+    base.force_insert("orientation", orientation);
+    robot.force_insert("base", base);
+
+    YAML::Node arms(YAML::NodeType::Map);
+    for (std::size_t a = 0; a < options.arms_per_robot; a++)
+    {
+      const std::string arm_name = "arm_" + std::to_string(a);
+      arms.force_insert(arm_name, arm(random, options, name + "_" + arm_name));
+    }
+    robot.force_insert("arms", arms);
+    robots.force_insert(name, robot);
+  }
+  cell.force_insert("robots", robots);
+
+  YAML::Node sensors(YAML::NodeType::Map);
+  for (std::size_t s = 0; s < options.sensors; s++)
+  {
+    const std::string name = "sensor_" + std::to_string(s);
+    YAML::Node sensor(YAML::NodeType::Map);
+    sensor.force_insert("type", pick(random, { "camera", "force_torque", "lidar", "imu" }));
+    sensor.force_insert("frame", options.robots ? "robot_" + std::to_string(random.uniform(options.robots)) + "/tool"
+                                                : std::string("world"));
+    sensor.force_insert("rate", pick(random, { "30", "100", "500", "1000" }));
+    sensor.force_insert("topic", "/cell/" + name);
+    sensor.force_insert("offset", array(random, 6, -0.1, 0.1));
+    sensors.force_insert(name, sensor);
+  }
+  cell.force_insert("sensors", sensors);
+
+  YAML::Node root(YAML::NodeType::Map);
+  root.force_insert("cell", cell);
+  return root;
+}
+
+std::size_t count_nodes(const YAML::Node& node)
+{
+  std::size_t ret = 1;
+  if (node.IsMap())
+  {
+    for (const auto& kv : node)
+    {
+      ret += count_nodes(kv.second);
+    }
+  }
+  else if (node.IsSequence())
+  {
+    for (const auto& item : node)
+    {
+      ret += count_nodes(item);
+    }
+  }
+  return ret;
+}
+
+}  // namespace yaml
+}  // namespace cnr
@@ -0,0 +1,9 @@
+#include <cnr_yaml/cnr_yaml.h>
+
+// the explicit instantiations of the extern templates declared in impl/extern_templates.hpp
+#define CNR_YAML_TEMPLATE(T) CNR_YAML_INSTANTIATE(, T)
+CNR_YAML_COMMON_TYPES(CNR_YAML_TEMPLATE)
+#ifdef CNR_YAML_EXTERN_NUMERIC_TEMPLATES
+CNR_YAML_NUMERIC_TYPES(CNR_YAML_TEMPLATE)
+#endif
+#undef CNR_YAML_TEMPLATE
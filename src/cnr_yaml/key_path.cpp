@@ -0,0 +1,76 @@
+#include <algorithm>
+
+#include <cnr_yaml/key_path.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+KeyPath::KeyPath(const std::string& path, const std::string& delimeters)
+{
+  std::size_t begin = 0;
+  while (begin <= path.size())
+  {
+    std::size_t end = path.find_first_of(delimeters, begin);
+    if (end == std::string::npos)
+    {
+      end = path.size();
+    }
+    if (end > begin)
+    {
+      keys_.push_back(path.substr(begin, end - begin));
+    }
+    begin = end + 1;
+  }
+}
+
+KeyPath::KeyPath(std::vector<std::string> keys) : keys_(std::move(keys))
+{
+}
+
+KeyPath KeyPath::parent() const
+{
+  KeyPath ret(*this);
+  if (!ret.keys_.empty())
+  {
+    ret.keys_.pop_back();
+  }
+  return ret;
+}
+
+KeyPath KeyPath::operator/(const std::string& key) const
+{
+  KeyPath ret(*this);
+  ret /= key;
+  return ret;
+}
+
+KeyPath& KeyPath::operator/=(const std::string& key)
+{
+  keys_.push_back(key);
+  return *this;
+}
+
+bool KeyPath::is_prefix_of(const KeyPath& other) const
+{
+  return keys_.size() <= other.keys_.size() && std::equal(keys_.begin(), keys_.end(), other.keys_.begin());
+}
+
+std::string KeyPath::str(const char& delimiter) const
+{
+  if (keys_.empty())
+  {
+    return std::string(1, delimiter);
+  }
+  std::string ret;
+  for (const auto& k : keys_)
+  {
+    ret += delimiter;
+    ret += k;
+  }
+  return ret;
+}
+
+}  // namespace yaml
+}  // namespace cnr
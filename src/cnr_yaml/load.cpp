@@ -0,0 +1,352 @@
+#include <algorithm>
+#include <atomic>
+#include <fnmatch.h>
+#include <fstream>
+#include <thread>
+#include <boost/filesystem.hpp>
+
+#include <cnr_yaml/compression.h>
+#include <cnr_yaml/document.h>
+#include <cnr_yaml/load.h>
+#include <cnr_yaml/node_utils.h>
+#include <cnr_yaml/parse_cache.h>
+#include <cnr_yaml/stream_reader.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+namespace
+{
+KeyPath strip_recursive_wildcard(const KeyPath& key)
+{
+  return !key.empty() && key.back() == "**" ? key.parent() : key;
+}
+
+void erase_subtree(const KeyPath& path, Provenance& provenance)
+{
+  // the descendants of a path follow it in the lexicographic order
+  auto it = provenance.lower_bound(path);
+  while (it != provenance.end() && path.is_prefix_of(it->first))
+  {
+    it = provenance.erase(it);
+  }
+}
+
+void record(const YAML::Node& node, const KeyPath& path, const std::string& file, Provenance& provenance)
+{
+  if (node.IsMap() && node.size())
+  {
+    for (const auto& child : node)
+    {
+      record(child.second, path / child.first.Scalar(), file, provenance);
+    }
+    return;
+  }
+  provenance[path] = file;
+}
+
+/**
+ * @brief merge_nodes, recording the file of the leaves set by the override node during the same walk
+ */
+YAML::Node merge_nodes(const YAML::Node& default_node, const YAML::Node& override_node, const KeyPath& path,
+                       const std::string& file, Provenance& provenance)
+{
+  if (!override_node.IsMap())
+  {
+    if (override_node.IsNull())
+    {
+      return default_node;
+    }
+    erase_subtree(path, provenance);
+    provenance[path] = file;
+    return override_node;
+  }
+  if (!default_node.IsMap() || !default_node.size())
+  {
+    erase_subtree(path, provenance);
+    record(override_node, path, file, provenance);
+    return override_node;
+  }
+
+  YAML::Node new_node(YAML::NodeType::Map);
+  for (const auto& node : default_node)
+  {
+    const YAML::Node over = node.first.IsScalar() ? override_node[node.first.Scalar()] : YAML::Node();
+    if (over)
+    {
+      new_node.force_insert(node.first, merge_nodes(node.second, over, path / node.first.Scalar(), file, provenance));
+    }
+    else
+    {
+      new_node.force_insert(node.first, node.second);
+    }
+  }
+  for (const auto& node : override_node)
+  {
+    if (!node.first.IsScalar() || !default_node[node.first.Scalar()])
+    {
+      record(node.second, path / node.first.Scalar(), file, provenance);
+      new_node.force_insert(node.first, node.second);
+    }
+  }
+  return new_node;
+}
+
+}  // namespace
+
+bool load_file(const std::string& path, YAML::Node& node, std::string& what, const LoadOptions& options)
+{
+  try
+  {
+    if (!options.use_mmap && options.cache_directory.empty())
+    {
+      std::ifstream file(path, std::ios::binary);
+      if (!file)
+      {
+        what = "Could not open the file '" + path + "'";
+        return false;
+      }
+      DecompressingStream input(file.rdbuf(), detect_compression(path, *file.rdbuf()));
+      node = YAML::Load(input);
+      return true;
+    }
+
+    MappedFile file;
+    if (!file.open(path, what))
+    {
+      return false;
+    }
+    file.advise(options.advice);
+
+    FrozenNode cached;
+    if (!options.cache_directory.empty() && cache::lookup(options.cache_directory, path, file, cached))
+    {
+      node = cached.to_node();
+      return true;
+    }
+
+    ViewStreamBuf buffer(file.view());
+    DecompressingStream input(&buffer, detect_compression(path, file.view()));
+    YAML::Node loaded = YAML::Load(input);
+    if (!options.cache_directory.empty())
+    {
+      // a failure of the cache is not a failure of the loading (it is counted in the cache_stats())
+      std::string cache_what;
+      cache::store(options.cache_directory, path, file, loaded, cache_what);
+    }
+    node = loaded;
+  }
+  catch (const std::exception& e)
+  {
+    what = "'" + path + "': " + e.what();
+    return false;
+  }
+  return true;
+}
+
+bool load_file(const std::string& path, FrozenNode& root, std::string& what, const LoadOptions& options)
+{
+  MappedFile file;
+  if (!file.open(path, what))
+  {
+    return false;
+  }
+  file.advise(options.advice);
+  if (!options.cache_directory.empty() && cache::lookup(options.cache_directory, path, file, root))
+  {
+    return true;
+  }
+
+  Document doc;
+  try
+  {
+    ViewStreamBuf buffer(file.view());
+    DecompressingStream input(&buffer, detect_compression(path, file.view()));
+    if (!doc.parse(input, what))
+    {
+      what = "'" + path + "': " + what;
+      return false;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    what = "'" + path + "': " + e.what();
+    return false;
+  }
+  if (!options.cache_directory.empty())
+  {
+    std::string cache_what;
+    cache::store(options.cache_directory, path, file, doc.root(), cache_what);
+  }
+  root = doc.root();
+  return true;
+}
+
+bool load_files(const std::vector<std::string>& paths, std::vector<YAML::Node>& nodes, std::string& what,
+                const std::size_t& n_threads, const LoadOptions& options)
+{
+  std::vector<YAML::Node> loaded(paths.size());
+  std::vector<std::string> errors(paths.size());
+  std::vector<char> ok(paths.size(), 0);
+
+  // each worker takes the next file: the results are stored by index, so that the output does not depend on the
+  // scheduling
+  std::atomic<std::size_t> next{ 0 };
+  auto worker = [&]() {
+    for (std::size_t i = next++; i < paths.size(); i = next++)
+    {
+      ok[i] = load_file(paths[i], loaded[i], errors[i], options);
+    }
+  };
+
+  std::size_t n = n_threads ? n_threads : std::max(1u, std::thread::hardware_concurrency());
+  n = std::min(n, paths.size());
+  if (n <= 1)
+  {
+    worker();
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < n; t++)
+    {
+      threads.emplace_back(worker);
+    }
+    for (auto& t : threads)
+    {
+      t.join();
+    }
+  }
+
+  std::string errs;
+  for (std::size_t i = 0; i < paths.size(); i++)
+  {
+    if (!ok[i])
+    {
+      errs += (errs.empty() ? "" : "\n") + errors[i];
+    }
+  }
+  if (!errs.empty())
+  {
+    what = errs;
+    return false;
+  }
+  nodes = std::move(loaded);
+  return true;
+}
+
+bool load_and_merge_files(const std::vector<std::string>& paths, YAML::Node& merged, std::string& what,
+                          const std::size_t& n_threads, const LoadOptions& options)
+{
+  std::vector<YAML::Node> nodes;
+  if (!load_files(paths, nodes, what, n_threads, options))
+  {
+    return false;
+  }
+  YAML::Node ret;
+  for (const auto& n : nodes)
+  {
+    ret.reset(merge_nodes(ret, n));
+  }
+  merged = ret;
+  return true;
+}
+
+bool load_directory(const std::string& directory, const std::string& pattern, YAML::Node& merged, std::string& what,
+                    Provenance* provenance, const std::size_t& n_threads, const LoadOptions& options)
+{
+  namespace fs = boost::filesystem;
+  std::vector<std::string> names;
+  try
+  {
+    for (const auto& entry : fs::directory_iterator(directory))
+    {
+      const std::string name = entry.path().filename().string();
+      if (fs::is_regular_file(entry.status()) && ::fnmatch(pattern.c_str(), name.c_str(), FNM_PERIOD) == 0)
+      {
+        names.push_back(name);
+      }
+    }
+  }
+  catch (const fs::filesystem_error& e)
+  {
+    what = "Could not list the directory '" + directory + "': " + e.code().message();
+    return false;
+  }
+  std::sort(names.begin(), names.end());
+
+  std::vector<std::string> paths;
+  for (const auto& name : names)
+  {
+    paths.push_back((fs::path(directory) / name).string());
+  }
+  std::vector<YAML::Node> nodes;
+  if (!load_files(paths, nodes, what, n_threads, options))
+  {
+    return false;
+  }
+
+  YAML::Node ret;
+  Provenance prov;
+  for (std::size_t i = 0; i < nodes.size(); i++)
+  {
+    if (provenance)
+    {
+      ret.reset(merge_nodes(ret, nodes[i], KeyPath(), paths[i], prov));
+    }
+    else
+    {
+      ret.reset(cnr::yaml::merge_nodes(ret, nodes[i]));
+    }
+  }
+  merged = ret;
+  if (provenance)
+  {
+    *provenance = std::move(prov);
+  }
+  return true;
+}
+
+bool load_subtree(std::istream& input, const KeyPath& key, YAML::Node& subtree, std::string& what)
+{
+  StreamReader reader;
+  YAML::Node node;
+  reader.bind(strip_recursive_wildcard(key), node);
+  if (!reader.read(input, what))
+  {
+    return false;
+  }
+  subtree = node;
+  return true;
+}
+
+bool load_subtree(const std::string& path, const KeyPath& key, YAML::Node& subtree, std::string& what)
+{
+  MappedFile file;
+  if (!file.open(path, what))
+  {
+    return false;
+  }
+  file.advise(MappedFile::Advice::SEQUENTIAL);
+  try
+  {
+    ViewStreamBuf buffer(file.view());
+    DecompressingStream input(&buffer, detect_compression(path, file.view()));
+    if (!load_subtree(input, key, subtree, what))
+    {
+      what = "'" + path + "': " + what;
+      return false;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    what = "'" + path + "': " + e.what();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace yaml
+}  // namespace cnr
@@ -0,0 +1,144 @@
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cnr_yaml/mapped_file.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+  : data_(rhs.data_), size_(rhs.size_), mtime_(rhs.mtime_), open_(rhs.open_)
+{
+  rhs.data_ = nullptr;
+  rhs.size_ = 0;
+  rhs.open_ = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    close();
+    data_ = rhs.data_;
+    size_ = rhs.size_;
+    mtime_ = rhs.mtime_;
+    open_ = rhs.open_;
+    rhs.data_ = nullptr;
+    rhs.size_ = 0;
+    rhs.open_ = false;
+  }
+  return *this;
+}
+
+bool MappedFile::open(const std::string& path, std::string& what)
+{
+  close();
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    what = "Could not open the file '" + path + "': " + std::strerror(errno);
+    return false;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+  {
+    what = "Could not stat the file '" + path + "': " + std::strerror(errno);
+    ::close(fd);
+    return false;
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+  mtime_ = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+  if (size_ > 0)
+  {
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+      what = "Could not map the file '" + path + "': " + std::strerror(errno);
+      size_ = 0;
+      ::close(fd);
+      return false;
+    }
+    data_ = static_cast<const char*>(addr);
+  }
+  ::close(fd);
+  open_ = true;
+  return true;
+}
+
+void MappedFile::close()
+{
+  if (data_)
+  {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  mtime_ = 0;
+  open_ = false;
+}
+
+void MappedFile::advise(const Advice& advice) const
+{
+  if (!data_)
+  {
+    return;
+  }
+  int flag = MADV_NORMAL;
+  switch (advice)
+  {
+    case Advice::SEQUENTIAL:
+      flag = MADV_SEQUENTIAL;
+      break;
+    case Advice::RANDOM:
+      flag = MADV_RANDOM;
+      break;
+    case Advice::WILLNEED:
+      flag = MADV_WILLNEED;
+      break;
+    default:
+      break;
+  }
+  ::madvise(const_cast<char*>(data_), size_, flag);
+}
+
+ViewStreamBuf::ViewStreamBuf(std::string_view view)
+{
+  // the get area is never written: the const_cast is only required by the std::streambuf interface
+  char* begin = const_cast<char*>(view.data());
+  setg(begin, begin, begin + view.size());
+}
+
+ViewStreamBuf::pos_type ViewStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+  if (!(which & std::ios_base::in))
+  {
+    return pos_type(off_type(-1));
+  }
+  off_type base = dir == std::ios_base::beg ? 0 : dir == std::ios_base::cur ? gptr() - eback() : egptr() - eback();
+  off_type pos = base + off;
+  if (pos < 0 || pos > egptr() - eback())
+  {
+    return pos_type(off_type(-1));
+  }
+  setg(eback(), eback() + pos, egptr());
+  return pos_type(pos);
+}
+
+ViewStreamBuf::pos_type ViewStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+  return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+}  // namespace yaml
+}  // namespace cnr
@@ -1,19 +1,25 @@
 #include <cassert>
 #include <iostream>
+#include <unordered_map>
 #include <yaml-cpp/yaml.h>
 #include <boost/algorithm/string.hpp>
 
 //#include <cnr_yaml/filesystem.h>
 #include <cnr_yaml/string.h>
 #include <cnr_yaml/node_utils.h>
+#include <cnr_yaml/stats.h>
+#include <cnr_yaml/access_profile.h>
 
 namespace cnr
 {
 namespace yaml
 {
 
-const YAML::Node merge_nodes(const YAML::Node& default_node, const YAML::Node& override_node)
+namespace
+{
+const YAML::Node merge_nodes_impl(const YAML::Node& default_node, const YAML::Node& override_node)
 {
+  CNR_YAML_STATS_ADD(MERGE_NODES, 1);
   if (!override_node.IsMap())
   {
     // If override_node is not a map, merge result is override_node, unless override_node is null
@@ -35,7 +41,7 @@ const YAML::Node merge_nodes(const YAML::Node& default_node, const YAML::Node& o
     if (node.first.IsScalar())
     {
       const std::string& key = node.first.Scalar();
-      new_node[key] = bool(override_node[key]) ? merge_nodes(node.second, override_node[key]) : node.second;
+      new_node[key] = bool(override_node[key]) ? merge_nodes_impl(node.second, override_node[key]) : node.second;
     }
     else
     {
@@ -49,7 +55,7 @@ const YAML::Node merge_nodes(const YAML::Node& default_node, const YAML::Node& o
     {
       const std::string& key = node.first.Scalar();
       new_node[key] =
-          bool(default_node[key]) ? merge_nodes(default_node[key], node.second) : new_node[key] = node.second;
+          bool(default_node[key]) ? merge_nodes_impl(default_node[key], node.second) : new_node[key] = node.second;
     }
     else
     {
@@ -58,6 +64,13 @@ const YAML::Node merge_nodes(const YAML::Node& default_node, const YAML::Node& o
   }
   return YAML::Node(new_node);
 }
+}  // namespace
+
+const YAML::Node merge_nodes(const YAML::Node& default_node, const YAML::Node& override_node)
+{
+  CNR_YAML_STATS_SCOPE(MERGE_CALLS, MERGE_NS);
+  return merge_nodes_impl(default_node, override_node);
+}
 
 YAML::Node init_tree(const std::vector<std::string>& seq, const YAML::Node& node)
 {
@@ -288,8 +301,11 @@ size_t size(const YAML::Node& node)
  * @return true
  * @return false
  */
-bool get_leaf(const YAML::Node& node, const std::string& key, YAML::Node& leaf, std::string& what, const std::string& delimeters)
+namespace
+{
+bool get_leaf_impl(const YAML::Node& node, const std::string& key, YAML::Node& leaf, std::string& what, const std::string& delimeters)
 {
+  CNR_YAML_STATS_ADD(GET_LEAF_NODES, 1);
   const YAML::Node _node = node;
   std::vector<std::string> tokens; 
   std::vector<std::size_t> positions;
@@ -313,12 +329,135 @@ bool get_leaf(const YAML::Node& node, const std::string& key, YAML::Node& leaf,
     }
     else
     {
-      return get_leaf(_node[_token], _key, leaf, what, delimeters);
+      return get_leaf_impl(_node[_token], _key, leaf, what, delimeters);
     }
   }
   what = "The key '"+key+"' has been resolved in the token '"+_token+"' (and '"+_key+"') that is not in the node dictionary (Input Node: " + std::to_string(_node) + ")";
   return false;
 }
+}  // namespace
+
+bool get_leaf(const YAML::Node& node, const std::string& key, YAML::Node& leaf, std::string& what, const std::string& delimeters)
+{
+  CNR_YAML_STATS_SCOPE(GET_LEAF_CALLS, GET_LEAF_NS);
+  detail::AccessTimer timer;
+  const bool ok = get_leaf_impl(node, key, leaf, what, delimeters);
+  if (ok)
+  {
+    timer.record(key, std::string_view(), delimeters);
+  }
+  else
+  {
+    CNR_YAML_STATS_ADD(WHAT_BYTES, what.size());
+  }
+  return ok;
+}
+
+namespace
+{
+std::string key_of(const YAML::Node& key)
+{
+  return key.IsScalar() ? key.Scalar() : std::to_string(key);
+}
+
+/**
+ * @brief A copy of the collection (same type, tag and style) without the children
+ */
+YAML::Node empty_like(const YAML::Node& node)
+{
+  YAML::Node ret(node.Type());
+  ret.SetTag(node.Tag());
+  ret.SetStyle(node.Style());
+  return ret;
+}
+
+/**
+ * @brief The non-specific tag "?" of the parsed plain nodes is the empty tag of the built ones (e.g. by merge_nodes)
+ */
+bool same_tag(const YAML::Node& a, const YAML::Node& b)
+{
+  auto specific = [](const std::string& tag) { return tag == "?" ? std::string() : tag; };
+  return specific(a.Tag()) == specific(b.Tag());
+}
+
+}  // namespace
+
+YAML::Node diff_nodes(const YAML::Node& previous, const YAML::Node& next, std::vector<KeyPath>& changed,
+                      const KeyPath& root)
+{
+  if (previous.Type() != next.Type() || !same_tag(previous, next))
+  {
+    changed.push_back(root);
+    return next;
+  }
+  const std::size_t n_changed = changed.size();
+  switch (next.Type())
+  {
+    case YAML::NodeType::Scalar:
+      if (previous.Scalar() != next.Scalar())
+      {
+        changed.push_back(root);
+        return next;
+      }
+      return previous;
+    case YAML::NodeType::Sequence:
+    {
+      if (previous.size() != next.size())
+      {
+        changed.push_back(root);
+        return next;
+      }
+      std::vector<YAML::Node> items;
+      for (std::size_t i = 0; i < next.size(); i++)
+      {
+        items.push_back(diff_nodes(previous[i], next[i], changed, root / std::to_string(i)));
+      }
+      if (changed.size() == n_changed)
+      {
+        return previous;
+      }
+      YAML::Node ret = empty_like(next);
+      for (const auto& item : items)
+      {
+        ret.push_back(item);
+      }
+      return ret;
+    }
+    case YAML::NodeType::Map:
+    {
+      std::unordered_map<std::string, YAML::Node> before;
+      for (const auto& kv : previous)
+      {
+        before.emplace(key_of(kv.first), kv.second);
+      }
+      YAML::Node ret = empty_like(next);
+      for (const auto& kv : next)
+      {
+        const std::string key = key_of(kv.first);
+        auto it = before.find(key);
+        if (it == before.end())
+        {
+          changed.push_back(root / key);
+          ret.force_insert(kv.first, kv.second);
+          continue;
+        }
+        ret.force_insert(kv.first, diff_nodes(it->second, kv.second, changed, root / key));
+        before.erase(it);
+      }
+      for (const auto& kv : previous)
+      {
+        const std::string key = key_of(kv.first);
+        if (before.count(key))
+        {
+          changed.push_back(root / key);
+        }
+      }
+      return changed.size() == n_changed ? previous : ret;
+    }
+    default:
+      return previous;
+  }
+}
 
 }  // namespace yaml
 }  // namespace cnr
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <boost/program_options/value_semantic.hpp>
+
+#include <cnr_yaml/key_path.h>
+#include <cnr_yaml/load.h>
+#include <cnr_yaml/node_utils.h>
+#include <cnr_yaml/overrides.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+namespace
+{
+using Set = std::pair<KeyPath, std::string>;
+
+bool parse_set(const std::string& option, Set& set, std::string& what)
+{
+  const std::size_t eq = option.find('=');
+  if (eq == std::string::npos)
+  {
+    what = "Invalid override '" + option + "': the format is path=value";
+    return false;
+  }
+  set.first = KeyPath(option.substr(0, eq));
+  set.second = option.substr(eq + 1);
+  if (set.first.empty())
+  {
+    what = "Invalid override '" + option + "': the path is empty";
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Build the tree of a run of --set. The paths are sorted, so that the maps of a common prefix are created once,
+ * and each key is inserted without a lookup.
+ */
+bool build(std::vector<Set> sets, YAML::Node& tree, std::string& what)
+{
+  std::stable_sort(sets.begin(), sets.end(), [](const Set& a, const Set& b) { return a.first < b.first; });
+
+  // the last of the equal paths wins, and a path is followed by its descendants
+  std::vector<Set> unique;
+  for (std::size_t i = 0; i < sets.size(); i++)
+  {
+    if (i + 1 < sets.size() && sets[i + 1].first == sets[i].first)
+    {
+      continue;
+    }
+    if (!unique.empty() && unique.back().first.is_prefix_of(sets[i].first))
+    {
+      what = "Conflicting overrides: '" + unique.back().first.str() + "' is set both as a value and as a map ('" +
+             sets[i].first.str() + "')";
+      return false;
+    }
+    unique.push_back(std::move(sets[i]));
+  }
+
+  YAML::Node root(YAML::NodeType::Map);
+  std::vector<YAML::Node> maps{ root };  // maps[i] is the map at the first i keys of 'current'
+  KeyPath current;
+  for (const auto& [path, text] : unique)
+  {
+    YAML::Node value;
+    try
+    {
+      value = YAML::Load(text);
+    }
+    catch (const YAML::Exception& e)
+    {
+      what = "Invalid value of the override '" + path.str() + "': " + e.what();
+      return false;
+    }
+
+    std::size_t common = 0;
+    while (common < current.size() && common + 1 < path.size() && current[common] == path[common])
+    {
+      common++;
+    }
+    while (current.size() > common)
+    {
+      current.pop_back();
+      maps.pop_back();
+    }
+    for (std::size_t i = common; i + 1 < path.size(); i++)
+    {
+      YAML::Node map(YAML::NodeType::Map);
+      maps.back().force_insert(path[i], map);
+      maps.push_back(map);
+      current /= path[i];
+    }
+    maps.back().force_insert(path.back(), value);
+  }
+  tree = root;
+  return true;
+}
+
+}  // namespace
+
+boost::program_options::options_description override_options()
+{
+  namespace po = boost::program_options;
+  po::options_description desc("Configuration overrides");
+  desc.add_options()("set", po::value<std::vector<std::string>>()->composing(),
+                     "override a key, as path=value (the value is parsed as YAML)")(
+      "values", po::value<std::vector<std::string>>()->composing(), "override the keys with a YAML file");
+  return desc;
+}
+
+bool make_overrides(const boost::program_options::parsed_options& parsed, YAML::Node& overrides, std::string& what)
+{
+  YAML::Node ret;
+  std::vector<Set> sets;
+  auto flush = [&]() {
+    if (sets.empty())
+    {
+      return true;
+    }
+    YAML::Node tree;
+    if (!build(std::move(sets), tree, what))
+    {
+      return false;
+    }
+    sets.clear();
+    ret.reset(merge_nodes(ret, tree));
+    return true;
+  };
+
+  for (const auto& option : parsed.options)
+  {
+    if (option.string_key == "set")
+    {
+      for (const auto& value : option.value)
+      {
+        Set set;
+        if (!parse_set(value, set, what))
+        {
+          return false;
+        }
+        sets.push_back(std::move(set));
+      }
+    }
+    else if (option.string_key == "values")
+    {
+      if (!flush())
+      {
+        return false;
+      }
+      for (const auto& path : option.value)
+      {
+        YAML::Node values;
+        if (!load_file(path, values, what))
+        {
+          return false;
+        }
+        ret.reset(merge_nodes(ret, values));
+      }
+    }
+  }
+  if (!flush())
+  {
+    return false;
+  }
+  overrides = ret;
+  return true;
+}
+
+bool parse_overrides(int argc, const char* const argv[], YAML::Node& overrides, std::string& what)
+{
+  namespace po = boost::program_options;
+  try
+  {
+    const po::parsed_options parsed =
+        po::command_line_parser(argc, argv).options(override_options()).allow_unregistered().run();
+    return make_overrides(parsed, overrides, what);
+  }
+  catch (const po::error& e)
+  {
+    what = std::string("Invalid command line: ") + e.what();
+    return false;
+  }
+}
+
+bool apply_overrides(int argc, const char* const argv[], YAML::Node& config, std::string& what)
+{
+  YAML::Node overrides;
+  if (!parse_overrides(argc, argv, overrides, what))
+  {
+    return false;
+  }
+  if (!overrides.IsNull())
+  {
+    config = merge_nodes(config, overrides);
+  }
+  return true;
+}
+
+}  // namespace yaml
+}  // namespace cnr
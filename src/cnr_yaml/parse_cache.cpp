@@ -0,0 +1,192 @@
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <unistd.h>
+
+#include <cnr_yaml/hash.h>
+#include <cnr_yaml/parse_cache.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+namespace
+{
+std::atomic<std::uint64_t> hits{ 0 };
+std::atomic<std::uint64_t> misses{ 0 };
+std::atomic<std::uint64_t> stores{ 0 };
+std::atomic<std::uint64_t> errors{ 0 };
+
+std::string absolute_path(const std::string& path)
+{
+  std::error_code ec;
+  auto abs = std::filesystem::absolute(path, ec);
+  return ec ? path : abs.lexically_normal().string();
+}
+
+}  // namespace
+
+namespace cache
+{
+
+std::string entry_path(const std::string& cache_directory, const std::string& path)
+{
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.cnrcache",
+                static_cast<unsigned long long>(fnv1a(absolute_path(path))));
+  return (std::filesystem::path(cache_directory) / name).string();
+}
+
+bool lookup(const std::string& cache_directory, const std::string& path, const MappedFile& file, FrozenNode& root)
+{
+  auto entry = std::make_shared<MappedFile>();
+  std::string what;
+  if (!entry->open(entry_path(cache_directory, path), what) || entry->size() < sizeof(Header))
+  {
+    misses++;
+    return false;
+  }
+  Header h;
+  std::memcpy(&h, entry->data(), sizeof(Header));
+  if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION || h.frozen_version != frozen::VERSION ||
+      h.mtime != file.mtime() || h.file_size != file.size() || h.path_hash != fnv1a(absolute_path(path)) ||
+      h.blob_size > entry->size() - sizeof(Header) || h.content_hash != xxh64(file.data(), file.size()))
+  {
+    misses++;
+    return false;
+  }
+  try
+  {
+    auto image = std::make_shared<const frozen::Image>(entry, entry->data() + sizeof(Header), h.blob_size);
+    if (!frozen::validate(*image, what))
+    {
+      misses++;
+      return false;
+    }
+    root = FrozenNode(image);
+  }
+  catch (const std::exception&)
+  {
+    misses++;
+    return false;
+  }
+  hits++;
+  return true;
+}
+
+bool store(const std::string& cache_directory, const std::string& path, const MappedFile& file,
+           const FrozenNode& root, std::string& what)
+{
+  std::error_code ec;
+  std::filesystem::create_directories(cache_directory, ec);
+  if (ec)
+  {
+    what = "Could not create the cache directory '" + cache_directory + "': " + ec.message();
+    errors++;
+    return false;
+  }
+  // a subtree is frozen again, so that the entry is the root of its blob
+  FrozenNode frozen = root;
+  if (root.entry() != root.image()->entries())
+  {
+    try
+    {
+      frozen = FrozenNode(root.to_node());
+    }
+    catch (const std::exception& e)
+    {
+      what = std::string("Could not freeze the tree: ") + e.what();
+      errors++;
+      return false;
+    }
+  }
+
+  Header h;
+  std::memset(&h, 0, sizeof(Header));
+  std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+  h.version = VERSION;
+  h.frozen_version = frozen::VERSION;
+  h.mtime = file.mtime();
+  h.file_size = file.size();
+  h.content_hash = xxh64(file.data(), file.size());
+  h.path_hash = fnv1a(absolute_path(path));
+  h.blob_size = frozen.image()->bytes();
+
+  const std::string final_path = entry_path(cache_directory, path);
+  const std::string tmp = final_path + ".tmp." + std::to_string(::getpid()) + "." +
+                          std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+      what = "Could not open the file '" + tmp + "': " + std::strerror(errno);
+      errors++;
+      return false;
+    }
+    out.write(reinterpret_cast<const char*>(&h), sizeof(Header));
+    out.write(static_cast<const char*>(frozen.image()->data()), static_cast<std::streamsize>(h.blob_size));
+    out.close();
+    if (!out)
+    {
+      what = "Could not write the file '" + tmp + "'";
+      std::remove(tmp.c_str());
+      errors++;
+      return false;
+    }
+  }
+  if (std::rename(tmp.c_str(), final_path.c_str()) != 0)
+  {
+    what = "Could not rename '" + tmp + "' in '" + final_path + "': " + std::strerror(errno);
+    std::remove(tmp.c_str());
+    errors++;
+    return false;
+  }
+  stores++;
+  return true;
+}
+
+bool store(const std::string& cache_directory, const std::string& path, const MappedFile& file,
+           const YAML::Node& root, std::string& what)
+{
+  FrozenNode frozen;
+  try
+  {
+    frozen = FrozenNode(root);
+  }
+  catch (const std::exception& e)
+  {
+    what = std::string("Could not freeze the tree: ") + e.what();
+    errors++;
+    return false;
+  }
+  return store(cache_directory, path, file, frozen, what);
+}
+
+}  // namespace cache
+
+CacheStats cache_stats()
+{
+  CacheStats ret;
+  ret.hits = hits;
+  ret.misses = misses;
+  ret.stores = stores;
+  ret.errors = errors;
+  return ret;
+}
+
+void reset_cache_stats()
+{
+  hits = 0;
+  misses = 0;
+  stores = 0;
+  errors = 0;
+}
+
+}  // namespace yaml
+}  // namespace cnr
@@ -0,0 +1,335 @@
+#include <algorithm>
+#include <charconv>
+#include <fnmatch.h>
+#include <regex>
+
+#include <cnr_yaml/select.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+struct Selector::Compiled
+{
+  struct Token
+  {
+    enum Kind
+    {
+      LITERAL,
+      WILDCARD,
+      RECURSIVE
+    } kind;
+    std::string text;
+  };
+
+  Mode mode = Mode::GLOB;
+  std::vector<Token> tokens;
+  std::regex regex;
+
+  /**
+   * @brief Every path matching the regex starts with it
+   */
+  std::string prefix;
+};
+
+namespace
+{
+using Token = Selector::Compiled::Token;
+
+/**
+ * @brief The states of the glob are the numbers of tokens matched so far. A "**" also matches zero keys, so that
+ * the next token is a state as well.
+ */
+using States = std::vector<std::size_t>;
+
+void close(const std::vector<Token>& tokens, States& states)
+{
+  for (std::size_t i = 0; i < states.size(); i++)
+  {
+    const std::size_t s = states[i];
+    if (s < tokens.size() && tokens[s].kind == Token::RECURSIVE &&
+        std::find(states.begin(), states.end(), s + 1) == states.end())
+    {
+      states.push_back(s + 1);
+    }
+  }
+  std::sort(states.begin(), states.end());
+}
+
+States step(const std::vector<Token>& tokens, const States& states, const std::string& key)
+{
+  States next;
+  for (const auto& s : states)
+  {
+    if (s == tokens.size())
+    {
+      continue;
+    }
+    const Token& token = tokens[s];
+    if (token.kind == Token::RECURSIVE)
+    {
+      next.push_back(s);
+    }
+    else if (token.kind == Token::LITERAL ? token.text == key : ::fnmatch(token.text.c_str(), key.c_str(), 0) == 0)
+    {
+      next.push_back(s + 1);
+    }
+  }
+  close(tokens, next);
+  next.erase(std::unique(next.begin(), next.end()), next.end());
+  return next;
+}
+
+/**
+ * @brief Parse a sequence index. A key that is not a plain decimal number, or that does not fit a std::size_t, is not
+ * an index.
+ */
+bool to_index(const std::string& key, std::size_t& index)
+{
+  if (key.empty() || !std::all_of(key.begin(), key.end(), [](char c) { return c >= '0' && c <= '9'; }))
+  {
+    return false;
+  }
+  auto [ptr, ec] = std::from_chars(key.data(), key.data() + key.size(), index);
+  return ec == std::errc() && ptr == key.data() + key.size();
+}
+
+void walk_glob(const std::vector<Token>& tokens, const YAML::Node& node, KeyPath& path, const States& states,
+               std::vector<Match>& matches)
+{
+  if (states.back() == tokens.size())
+  {
+    matches.push_back({ path, node });
+  }
+  if (!node.IsMap() && !node.IsSequence())
+  {
+    return;
+  }
+
+  auto descend = [&](const std::string& key, const YAML::Node& child) {
+    States next = step(tokens, states, key);
+    if (!next.empty())
+    {
+      path /= key;
+      walk_glob(tokens, child, path, next, matches);
+      path.pop_back();
+    }
+  };
+
+  // if all the pending tokens are literals, the children are looked up, and the other ones are never visited
+  std::vector<std::string> literals;
+  for (const auto& s : states)
+  {
+    if (s == tokens.size())
+    {
+      continue;
+    }
+    if (tokens[s].kind != Token::LITERAL)
+    {
+      literals.clear();
+      break;
+    }
+    literals.push_back(tokens[s].text);
+  }
+  if (!literals.empty())
+  {
+    std::sort(literals.begin(), literals.end());
+    literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+    for (const auto& key : literals)
+    {
+      if (node.IsMap())
+      {
+        const YAML::Node child = node[key];
+        if (child)
+        {
+          descend(key, child);
+        }
+      }
+      else if (std::size_t index = 0; to_index(key, index) && index < node.size())
+      {
+        descend(key, node[index]);
+      }
+    }
+    return;
+  }
+  if (std::all_of(states.begin(), states.end(), [&](std::size_t s) { return s == tokens.size(); }))
+  {
+    return;
+  }
+
+  if (node.IsMap())
+  {
+    for (const auto& child : node)
+    {
+      if (child.first.IsScalar())
+      {
+        descend(child.first.Scalar(), child.second);
+      }
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < node.size(); i++)
+    {
+      descend(std::to_string(i), node[i]);
+    }
+  }
+}
+
+/**
+ * @brief The literal characters at the beginning of the regex. Empty if the regex has an alternation.
+ */
+std::string literal_prefix(const std::string& pattern)
+{
+  if (pattern.find('|') != std::string::npos)
+  {
+    return std::string();
+  }
+  const std::string special = ".[]{}()*+?^$|\\";
+  std::size_t i = pattern.starts_with("^") ? 1 : 0;
+  std::string ret;
+  for (; i < pattern.size() && special.find(pattern[i]) == std::string::npos; i++)
+  {
+    ret += pattern[i];
+  }
+  // a quantifier applies to the last literal
+  if (i < pattern.size() && !ret.empty() && (pattern[i] == '*' || pattern[i] == '?' || pattern[i] == '{'))
+  {
+    ret.pop_back();
+  }
+  return ret;
+}
+
+void walk_regex(const Selector::Compiled& compiled, const YAML::Node& node, KeyPath& path, const std::string& str,
+                std::vector<Match>& matches)
+{
+  // the paths of the subtree start with str: if it diverges from the literal prefix, no descendant can match
+  if (!compiled.prefix.starts_with(str) && !str.starts_with(compiled.prefix))
+  {
+    return;
+  }
+  if (std::regex_match(str, compiled.regex))
+  {
+    matches.push_back({ path, node });
+  }
+
+  const std::string prefix = path.empty() ? std::string() : str;
+  if (node.IsMap())
+  {
+    for (const auto& child : node)
+    {
+      if (child.first.IsScalar())
+      {
+        path /= child.first.Scalar();
+        walk_regex(compiled, child.second, path, prefix + "/" + child.first.Scalar(), matches);
+        path.pop_back();
+      }
+    }
+  }
+  else if (node.IsSequence())
+  {
+    for (std::size_t i = 0; i < node.size(); i++)
+    {
+      path /= std::to_string(i);
+      walk_regex(compiled, node[i], path, prefix + "/" + std::to_string(i), matches);
+      path.pop_back();
+    }
+  }
+}
+
+}  // namespace
+
+bool Selector::compile(const std::string& pattern, const Mode& mode, std::string& what)
+{
+  auto compiled = std::make_shared<Compiled>();
+  compiled->mode = mode;
+  if (mode == Mode::REGEX)
+  {
+    try
+    {
+      compiled->regex = std::regex(pattern, std::regex::ECMAScript | std::regex::optimize);
+      compiled->prefix = literal_prefix(pattern);
+    }
+    catch (const std::regex_error& e)
+    {
+      what = "Invalid regex '" + pattern + "': " + e.what();
+      return false;
+    }
+  }
+  else
+  {
+    const KeyPath keys(pattern, "/");
+    for (const auto& key : keys.keys())
+    {
+      Token token;
+      token.text = key;
+      token.kind = key == "**"                                      ? Token::RECURSIVE :
+                   key.find_first_of("*?[\\") != std::string::npos ? Token::WILDCARD :
+                                                                      Token::LITERAL;
+      compiled->tokens.push_back(token);
+    }
+  }
+  pattern_ = pattern;
+  compiled_ = compiled;
+  return true;
+}
+
+std::vector<Match> Selector::select(const YAML::Node& node) const
+{
+  std::vector<Match> matches;
+  if (!compiled_ || !node)
+  {
+    return matches;
+  }
+  KeyPath path;
+  if (compiled_->mode == Mode::REGEX)
+  {
+    walk_regex(*compiled_, node, path, path.str(), matches);
+  }
+  else
+  {
+    States states{ 0 };
+    close(compiled_->tokens, states);
+    walk_glob(compiled_->tokens, node, path, states, matches);
+  }
+  return matches;
+}
+
+bool Selector::matches(const KeyPath& path) const
+{
+  if (!compiled_)
+  {
+    return false;
+  }
+  if (compiled_->mode == Mode::REGEX)
+  {
+    return std::regex_match(path.str(), compiled_->regex);
+  }
+  States states{ 0 };
+  close(compiled_->tokens, states);
+  for (const auto& key : path.keys())
+  {
+    states = step(compiled_->tokens, states, key);
+    if (states.empty())
+    {
+      return false;
+    }
+  }
+  return states.back() == compiled_->tokens.size();
+}
+
+bool select(const YAML::Node& node, const std::string& pattern, std::vector<Match>& matches, std::string& what,
+            const Selector::Mode& mode)
+{
+  Selector selector;
+  if (!selector.compile(pattern, mode, what))
+  {
+    return false;
+  }
+  matches = selector.select(node);
+  return true;
+}
+
+}  // namespace yaml
+}  // namespace cnr
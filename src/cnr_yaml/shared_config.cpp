@@ -0,0 +1,466 @@
+#include <algorithm>
+#include <charconv>
+#include <semaphore>
+#include <thread>
+
+#include <cnr_yaml/node_utils.h>
+#include <cnr_yaml/shared_config.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+namespace
+{
+/**
+ * @brief Replace the subtree of a key, creating the missing maps (and replacing the null nodes) of the path
+ */
+bool set_subtree(YAML::Node& root, const KeyPath& key, const YAML::Node& value, std::string& what)
+{
+  if (key.empty())
+  {
+    root.reset(value);
+    return true;
+  }
+  if (!root.IsDefined() || root.IsNull())
+  {
+    root.reset(YAML::Node(YAML::NodeType::Map));
+  }
+  YAML::Node node;
+  node.reset(root);
+  for (std::size_t i = 0; i + 1 < key.size(); i++)
+  {
+    if (!node.IsMap())
+    {
+      what = "The key '" + key.str() + "' cannot be set: '" + KeyPath(std::vector<std::string>(
+                 key.keys().begin(), key.keys().begin() + i)).str() + "' is not a map";
+      return false;
+    }
+    YAML::Node child = node[key[i]];
+    if (!child.IsDefined() || child.IsNull())
+    {
+      node[key[i]] = YAML::Node(YAML::NodeType::Map);
+      child.reset(node[key[i]]);
+    }
+    node.reset(child);
+  }
+  if (!node.IsMap())
+  {
+    what = "The key '" + key.str() + "' cannot be set: '" + key.parent().str() + "' is not a map";
+    return false;
+  }
+  node[key.back()] = value;
+  return true;
+}
+
+/**
+ * @brief True if a change of one path may change the other one (one is the path of the other, or of an ancestor)
+ */
+bool overlap(const KeyPath& a, const KeyPath& b)
+{
+  return a.is_prefix_of(b) || b.is_prefix_of(a);
+}
+
+/**
+ * @brief Child of a node along a key path: the components are keys of the maps and indexes of the sequences (as
+ * diff_nodes reports them). An undefined node is returned if the child is missing.
+ */
+FrozenNode child(const FrozenNode& node, const std::string& component)
+{
+  if (node.IsMap())
+  {
+    return node[std::string_view(component)];
+  }
+  std::size_t index = 0;
+  if (node.IsSequence() && !component.empty() &&
+      std::all_of(component.begin(), component.end(), [](char c) { return c >= '0' && c <= '9'; }))
+  {
+    auto [ptr, ec] = std::from_chars(component.data(), component.data() + component.size(), index);
+    if (ec == std::errc() && ptr == component.data() + component.size())
+    {
+      return node[index];
+    }
+  }
+  return FrozenNode();
+}
+
+/**
+ * @brief diff_nodes on two frozen trees: it appends the paths of the changed nodes (the deepest ones) under root
+ */
+void diff_frozen(const FrozenNode& previous, const FrozenNode& next, const KeyPath& root, std::vector<KeyPath>& changed)
+{
+  // the non-specific tag "?" of the parsed plain nodes is the empty tag of the built ones, as in diff_nodes
+  auto specific = [](std::string_view tag) { return tag == "?" ? std::string_view() : tag; };
+  if (previous.Type() != next.Type() || specific(previous.Tag()) != specific(next.Tag()))
+  {
+    changed.push_back(root);
+    return;
+  }
+  switch (next.Type())
+  {
+    case YAML::NodeType::Scalar:
+      if (previous.Scalar() != next.Scalar())
+      {
+        changed.push_back(root);
+      }
+      return;
+    case YAML::NodeType::Sequence:
+      if (previous.size() != next.size())
+      {
+        changed.push_back(root);
+        return;
+      }
+      for (std::size_t i = 0; i < next.size(); i++)
+      {
+        diff_frozen(previous[i], next[i], root / std::to_string(i), changed);
+      }
+      return;
+    case YAML::NodeType::Map:
+      for (const FrozenNode item : next)
+      {
+        const FrozenNode before = previous[item.key()];
+        if (before)
+        {
+          diff_frozen(before, item, root / std::string(item.key()), changed);
+        }
+        else
+        {
+          changed.push_back(root / std::string(item.key()));
+        }
+      }
+      for (const FrozenNode item : previous)
+      {
+        if (!next[item.key()])
+        {
+          changed.push_back(root / std::string(item.key()));
+        }
+      }
+      return;
+    default:
+      return;
+  }
+}
+
+FrozenNode descend(FrozenNode node, const KeyPath& path)
+{
+  for (std::size_t i = 0; i < path.size() && node; i++)
+  {
+    node = child(node, path[i]);
+  }
+  return node;
+}
+}  // namespace
+
+struct SharedConfig::Dispatcher
+{
+  struct Subscriber
+  {
+    std::size_t id;
+    KeyPath prefix;
+    Callback callback;
+  };
+
+  void run(const SharedConfig& config);
+  void dispatch(const std::shared_ptr<const Snapshot>& previous, const std::shared_ptr<const Snapshot>& current,
+                const std::vector<KeyPath>& touched);
+
+  std::mutex mtx;
+  std::counting_semaphore<> wake{ 0 };  // released when pending or stop is set
+  std::vector<Subscriber> subscribers;
+  std::size_t next_id = 0;
+  bool pending = false;
+  bool stop = false;
+  std::shared_ptr<const Snapshot> previous;  // the snapshot of the last notification
+  std::vector<KeyPath> touched;              // the paths touched by the updates coalesced in the pending notification
+  std::thread thread;
+
+  std::mutex callback_mtx;  // held while the callbacks run, so that unsubscribe waits for them
+};
+
+void SharedConfig::Dispatcher::run(const SharedConfig& config)
+{
+  while (true)
+  {
+    wake.acquire();
+    std::unique_lock<std::mutex> lock(mtx);
+    if (stop)
+    {
+      return;
+    }
+    // all the updates published since the last notification are coalesced
+    pending = false;
+    std::shared_ptr<const Snapshot> last = previous;
+    previous = config.snapshot();
+    std::shared_ptr<const Snapshot> current = previous;
+    std::vector<KeyPath> paths;
+    paths.swap(touched);
+    lock.unlock();
+    dispatch(last, current, paths);
+  }
+}
+
+void SharedConfig::Dispatcher::dispatch(const std::shared_ptr<const Snapshot>& previous,
+                                        const std::shared_ptr<const Snapshot>& current,
+                                        const std::vector<KeyPath>& touched)
+{
+  std::lock_guard<std::mutex> callback_lock(callback_mtx);
+  std::vector<Subscriber> subscribers_copy;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    subscribers_copy = subscribers;
+  }
+
+  // only the subtrees both touched and subscribed are compared: the deeper of the two paths, when they overlap
+  std::vector<KeyPath> regions;
+  for (const auto& s : subscribers_copy)
+  {
+    for (const auto& path : touched)
+    {
+      if (overlap(s.prefix, path))
+      {
+        regions.push_back(s.prefix.size() >= path.size() ? s.prefix : path);
+      }
+    }
+  }
+  if (regions.empty())
+  {
+    return;
+  }
+  // sorted, a region follows the regions of its ancestors, that already cover it
+  std::sort(regions.begin(), regions.end());
+  std::vector<KeyPath> roots;
+  for (const auto& region : regions)
+  {
+    if (roots.empty() || !roots.back().is_prefix_of(region))
+    {
+      roots.push_back(region);
+    }
+  }
+
+  std::vector<KeyPath> changed;
+  for (const auto& root : roots)
+  {
+    diff_frozen(descend(previous->root, root), descend(current->root, root), root, changed);
+  }
+  if (changed.empty())
+  {
+    return;
+  }
+  for (const auto& s : subscribers_copy)
+  {
+    Notification notification;
+    for (const auto& path : changed)
+    {
+      if (overlap(s.prefix, path))
+      {
+        notification.changed.push_back(path);
+      }
+    }
+    if (notification.changed.empty())
+    {
+      continue;
+    }
+    notification.version = current->version;
+    notification.prefix = s.prefix;
+    notification.snapshot = current;
+    notification.value = descend(current->root, s.prefix);
+    s.callback(notification);
+  }
+}
+
+SharedConfig::Reader::Reader(const SharedConfig& config) : config_(config), snapshot_(config.snapshot())
+{
+}
+
+const FrozenNode& SharedConfig::Reader::get()
+{
+  if (config_.version() != snapshot_->version)
+  {
+    snapshot_ = config_.snapshot();
+  }
+  return snapshot_->root;
+}
+
+SharedConfig::SharedConfig() : dispatcher_(std::make_unique<Dispatcher>()), current_(std::make_shared<const Snapshot>())
+{
+}
+
+SharedConfig::~SharedConfig()
+{
+  {
+    std::lock_guard<std::mutex> lock(dispatcher_->mtx);
+    dispatcher_->stop = true;
+  }
+  dispatcher_->wake.release();
+  if (dispatcher_->thread.joinable())
+  {
+    dispatcher_->thread.join();
+  }
+}
+
+SharedConfig::SharedConfig(const YAML::Node& config) : SharedConfig()
+{
+  publish(config);
+}
+
+std::shared_ptr<const SharedConfig::Snapshot> SharedConfig::snapshot() const
+{
+#if defined(__cpp_lib_atomic_shared_ptr)
+  return current_.load(std::memory_order_acquire);
+#else
+  std::lock_guard<std::mutex> lock(current_mtx_);
+  return current_;
+#endif
+}
+
+std::uint64_t SharedConfig::publish(const YAML::Node& config)
+{
+  // the freezing is the expensive part, and it is done before taking the lock
+  return publish(FrozenNode(config));
+}
+
+std::uint64_t SharedConfig::publish(const FrozenNode& config)
+{
+  static const KeyPath root;
+  std::lock_guard<std::mutex> lock(writer_mtx_);
+  const std::uint64_t ret = store(config);
+  notify(&root, 1);
+  return ret;
+}
+
+std::uint64_t SharedConfig::merge(const YAML::Node& overrides)
+{
+  Batch batch(*this);
+  batch.merge(overrides);
+  std::string what;
+  return batch.commit(what);
+}
+
+std::uint64_t SharedConfig::set_leaf(const KeyPath& key, const YAML::Node& value, std::string& what)
+{
+  Batch batch(*this);
+  batch.set_leaf(key, value);
+  return batch.commit(what);
+}
+
+std::size_t SharedConfig::subscribe(const KeyPath& prefix, const Callback& callback)
+{
+  std::lock_guard<std::mutex> lock(dispatcher_->mtx);
+  if (!dispatcher_->thread.joinable())
+  {
+    dispatcher_->thread = std::thread([this]() { dispatcher_->run(*this); });
+  }
+  if (!dispatcher_->pending)
+  {
+    // the changes published before the subscription are not notified
+    dispatcher_->previous = snapshot();
+  }
+  dispatcher_->subscribers.push_back(Dispatcher::Subscriber{ dispatcher_->next_id, prefix, callback });
+  subscribers_.fetch_add(1, std::memory_order_relaxed);
+  return dispatcher_->next_id++;
+}
+
+void SharedConfig::unsubscribe(const std::size_t& id)
+{
+  std::lock_guard<std::mutex> callback_lock(dispatcher_->callback_mtx);
+  std::lock_guard<std::mutex> lock(dispatcher_->mtx);
+  auto& subscribers = dispatcher_->subscribers;
+  auto it = std::remove_if(subscribers.begin(), subscribers.end(),
+                           [&id](const Dispatcher::Subscriber& s) { return s.id == id; });
+  subscribers_.fetch_sub(static_cast<std::size_t>(subscribers.end() - it), std::memory_order_relaxed);
+  subscribers.erase(it, subscribers.end());
+}
+
+void SharedConfig::notify(const KeyPath* touched, const std::size_t& n)
+{
+  if (subscribers_.load(std::memory_order_relaxed) == 0)
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(dispatcher_->mtx);
+  if (dispatcher_->pending)
+  {
+    // coalesced with the pending notification
+    dispatcher_->touched.insert(dispatcher_->touched.end(), touched, touched + n);
+    return;
+  }
+  for (std::size_t i = 0; i < n; i++)
+  {
+    for (const auto& s : dispatcher_->subscribers)
+    {
+      if (overlap(s.prefix, touched[i]))
+      {
+        dispatcher_->pending = true;
+        dispatcher_->touched.assign(touched, touched + n);
+        dispatcher_->wake.release();
+        return;
+      }
+    }
+  }
+  // nobody is interested: the next notification starts from this snapshot
+  dispatcher_->previous = snapshot();
+}
+
+SharedConfig::Batch::Batch(SharedConfig& config) : config_(config)
+{
+}
+
+void SharedConfig::Batch::set_leaf(const KeyPath& key, const YAML::Node& value)
+{
+  // a copy: the later edits of the batch are written in the tree, and they must not reach the node of the caller
+  edits_.push_back(Edit{ key, YAML::Clone(value), false });
+}
+
+void SharedConfig::Batch::merge(const YAML::Node& overrides)
+{
+  edits_.push_back(Edit{ KeyPath(), YAML::Clone(overrides), true });
+}
+
+std::uint64_t SharedConfig::Batch::commit(std::string& what)
+{
+  std::vector<Edit> edits;
+  edits.swap(edits_);
+
+  std::lock_guard<std::mutex> lock(config_.writer_mtx_);
+  YAML::Node tree = config_.snapshot()->root.to_node();
+  std::vector<KeyPath> touched;
+  touched.reserve(edits.size());
+  for (const auto& edit : edits)
+  {
+    if (edit.merge)
+    {
+      tree.reset(merge_nodes(tree, edit.value));
+    }
+    else if (!set_subtree(tree, edit.key, edit.value, what))
+    {
+      return 0;
+    }
+    touched.push_back(edit.key);
+  }
+  const std::uint64_t ret = config_.store(FrozenNode(tree));
+  config_.notify(touched.data(), touched.size());
+  return ret;
+}
+
+std::uint64_t SharedConfig::store(const FrozenNode& root)
+{
+  auto next = std::make_shared<Snapshot>();
+  next->root = root;
+  next->version = version_.load(std::memory_order_relaxed) + 1;
+  const std::uint64_t ret = next->version;
+  // the snapshot is stored before the version, so that a reader that sees the new version finds the new snapshot
+#if defined(__cpp_lib_atomic_shared_ptr)
+  current_.store(std::move(next), std::memory_order_release);
+#else
+  {
+    std::lock_guard<std::mutex> lock(current_mtx_);
+    current_ = std::move(next);
+  }
+#endif
+  version_.store(ret, std::memory_order_release);
+  return ret;
+}
+
+}  // namespace yaml
+}  // namespace cnr
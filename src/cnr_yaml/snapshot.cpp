@@ -0,0 +1,97 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+
+#include <cnr_yaml/mapped_file.h>
+#include <cnr_yaml/snapshot.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+bool save_snapshot(const YAML::Node& node, const std::string& path, std::string& what)
+{
+  try
+  {
+    return save_snapshot(FrozenNode(node), path, what);
+  }
+  catch (const std::exception& e)
+  {
+    what = "Error in freezing the node: " + std::string(e.what());
+  }
+  return false;
+}
+
+bool save_snapshot(const FrozenNode& node, const std::string& path, std::string& what)
+{
+  if (!node)
+  {
+    what = "The snapshot of an undefined node cannot be saved";
+    return false;
+  }
+  if (node.entry() != node.image()->entries())
+  {
+    // a subtree: it is frozen again, so that it becomes the root of its own blob
+    return save_snapshot(node.to_node(), path, what);
+  }
+
+  const std::string tmp = path + ".tmp." + std::to_string(::getpid()) + "." +
+                          std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+      what = "Could not open the file '" + tmp + "': " + std::strerror(errno);
+      return false;
+    }
+    out.write(static_cast<const char*>(node.image()->data()), static_cast<std::streamsize>(node.image()->bytes()));
+    out.close();
+    if (!out)
+    {
+      what = "Could not write the file '" + tmp + "'";
+      std::remove(tmp.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp.c_str(), path.c_str()) != 0)
+  {
+    what = "Could not rename '" + tmp + "' in '" + path + "': " + std::strerror(errno);
+    std::remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool load_snapshot(const std::string& path, FrozenNode& root, std::string& what, const bool& validate)
+{
+  auto file = std::make_shared<MappedFile>();
+  if (!file->open(path, what))
+  {
+    return false;
+  }
+  try
+  {
+    auto image = std::make_shared<const frozen::Image>(file, file->data(), file->size());
+    if (validate && !frozen::validate(*image, what))
+    {
+      what = "'" + path + "': " + what;
+      return false;
+    }
+    root = FrozenNode(image);
+  }
+  catch (const std::exception& e)
+  {
+    what = "'" + path + "': " + e.what();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace yaml
+}  // namespace cnr
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <cnr_yaml/stats.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+namespace
+{
+
+struct Registry
+{
+  std::mutex mtx;
+  std::vector<detail::ThreadCounters*> threads;
+  std::array<std::uint64_t, detail::counters> retired{};  // the counters of the threads that have exited
+};
+
+Registry& registry()
+{
+  // never destroyed: the threads may exit after the static destructors
+  static Registry* instance = new Registry();
+  return *instance;
+}
+
+/**
+ * @brief The owner of the counters of a thread: it registers them, and folds them in the totals at the thread exit
+ */
+struct ThreadHolder
+{
+  detail::ThreadCounters counters;
+
+  ThreadHolder()
+  {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mtx);
+    r.threads.push_back(&counters);
+  }
+
+  ~ThreadHolder()
+  {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mtx);
+    for (std::size_t i = 0; i < detail::counters; i++)
+    {
+      r.retired[i] += counters.values[i].load(std::memory_order_relaxed);
+    }
+    r.threads.erase(std::remove(r.threads.begin(), r.threads.end(), &counters), r.threads.end());
+  }
+};
+
+}  // namespace
+
+namespace detail
+{
+ThreadCounters& thread_counters()
+{
+  thread_local ThreadHolder holder;
+  return holder.counters;
+}
+}  // namespace detail
+
+Stats stats()
+{
+  std::array<std::uint64_t, detail::counters> v{};
+  {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mtx);
+    v = r.retired;
+    for (const auto* t : r.threads)
+    {
+      for (std::size_t i = 0; i < detail::counters; i++)
+      {
+        v[i] += t->values[i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  using detail::Counter;
+  auto at = [&v](Counter c) { return v[static_cast<std::size_t>(c)]; };
+  Stats ret;
+  ret.get_calls = at(Counter::GET_CALLS);
+  ret.decode_alternatives = at(Counter::DECODE_ALTERNATIVES);
+  ret.decode_exceptions = at(Counter::DECODE_EXCEPTIONS);
+  ret.get_ns = at(Counter::GET_NS);
+  ret.set_calls = at(Counter::SET_CALLS);
+  ret.encode_alternatives = at(Counter::ENCODE_ALTERNATIVES);
+  ret.encode_exceptions = at(Counter::ENCODE_EXCEPTIONS);
+  ret.set_ns = at(Counter::SET_NS);
+  ret.get_leaf_calls = at(Counter::GET_LEAF_CALLS);
+  ret.get_leaf_nodes = at(Counter::GET_LEAF_NODES);
+  ret.get_leaf_ns = at(Counter::GET_LEAF_NS);
+  ret.merge_calls = at(Counter::MERGE_CALLS);
+  ret.merge_nodes = at(Counter::MERGE_NODES);
+  ret.merge_ns = at(Counter::MERGE_NS);
+  ret.what_bytes = at(Counter::WHAT_BYTES);
+  return ret;
+}
+
+void reset_stats()
+{
+  Registry& r = registry();
+  std::lock_guard<std::mutex> lock(r.mtx);
+  r.retired.fill(0);
+  for (auto* t : r.threads)
+  {
+    for (auto& value : t->values)
+    {
+      value.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+std::ostream& operator<<(std::ostream& os, const Stats& s)
+{
+  auto per_call = [](std::uint64_t ns, std::uint64_t calls) { return calls ? ns / calls : 0; };
+  os << "get:      " << s.get_calls << " calls, " << s.decode_alternatives << " alternatives, " << s.decode_exceptions
+     << " exceptions, " << s.get_ns << " ns (" << per_call(s.get_ns, s.get_calls) << " ns/call)\n";
+  os << "set:      " << s.set_calls << " calls, " << s.encode_alternatives << " alternatives, " << s.encode_exceptions
+     << " exceptions, " << s.set_ns << " ns (" << per_call(s.set_ns, s.set_calls) << " ns/call)\n";
+  os << "get_leaf: " << s.get_leaf_calls << " calls, " << s.get_leaf_nodes << " nodes visited, " << s.get_leaf_ns
+     << " ns (" << per_call(s.get_leaf_ns, s.get_leaf_calls) << " ns/call)\n";
+  os << "merge:    " << s.merge_calls << " calls, " << s.merge_nodes << " nodes visited, " << s.merge_ns << " ns ("
+     << per_call(s.merge_ns, s.merge_calls) << " ns/call)\n";
+  os << "what:     " << s.what_bytes << " bytes";
+  return os;
+}
+
+}  // namespace yaml
+}  // namespace cnr
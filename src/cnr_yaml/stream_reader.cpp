@@ -0,0 +1,843 @@
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <yaml-cpp/eventhandler.h>
+#include <yaml-cpp/parser.h>
+
+#include <cnr_yaml/compression.h>
+#include <cnr_yaml/frozen_node.h>
+#include <cnr_yaml/stream_reader.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+/**
+ * @brief It receives the events of the bound node (and of its children). finish() is called when the node is over.
+ */
+class StreamReader::Binding : public YAML::EventHandler
+{
+public:
+  explicit Binding(const KeyPath& path) : path_(path)
+  {
+  }
+
+  void OnDocumentStart(const YAML::Mark&) override
+  {
+  }
+  void OnDocumentEnd() override
+  {
+  }
+  virtual void finish() = 0;
+
+  /**
+   * @brief Clear the state left by a previous (failed) read
+   */
+  virtual void reset()
+  {
+    found = false;
+  }
+
+  const KeyPath& path() const
+  {
+    return path_;
+  }
+  bool found = false;
+
+protected:
+  [[noreturn]] void error(const std::string& msg) const
+  {
+    throw std::runtime_error("'" + path_.str() + "': " + msg);
+  }
+
+private:
+  KeyPath path_;
+};
+
+namespace
+{
+
+/**
+ * @brief A number, a sequence of numbers, or a sequence of sequences of numbers
+ */
+class NumericBinding : public StreamReader::Binding
+{
+public:
+  explicit NumericBinding(const KeyPath& path) : StreamReader::Binding(path)
+  {
+  }
+
+  void OnNull(const YAML::Mark&, YAML::anchor_t) override
+  {
+    error("a null value is not a number");
+  }
+  void OnAlias(const YAML::Mark&, YAML::anchor_t) override
+  {
+    error("the aliases are not supported by the streaming decoding");
+  }
+  void OnScalar(const YAML::Mark&, const std::string&, YAML::anchor_t, const std::string& value) override
+  {
+    std::int64_t as_integer = 0;
+    double as_double = 0.0;
+    if (!(frozen::parse_scalar(value, as_integer, as_double) & frozen::IS_DOUBLE))
+    {
+      error("'" + value + "' is not a number");
+    }
+    switch (level_)
+    {
+      case 0:
+        start();
+        push(0, 0, as_double);
+        rows_ = cols_ = 1;
+        break;
+      case 1:
+        if (nested_)
+        {
+          error("a sequence mixes numbers and sequences");
+        }
+        push(rows_++, 0, as_double);
+        cols_ = 1;
+        break;
+      default:
+        push(rows_, col_++, as_double);
+        break;
+    }
+  }
+  void OnSequenceStart(const YAML::Mark&, const std::string&, YAML::anchor_t, YAML::EmitterStyle::value) override
+  {
+    switch (level_)
+    {
+      case 0:
+        start();
+        rows_ = cols_ = 0;
+        nested_ = false;
+        break;
+      case 1:
+        if (rows_ > 0 && !nested_)
+        {
+          error("a sequence mixes numbers and sequences");
+        }
+        nested_ = true;
+        col_ = 0;
+        break;
+      default:
+        error("only numbers, sequences of numbers, and sequences of sequences of numbers are supported");
+    }
+    level_++;
+  }
+  void OnSequenceEnd() override
+  {
+    level_--;
+    if (level_ == 1)
+    {
+      if (rows_ > 0 && col_ != cols_)
+      {
+        row_mismatch(rows_, col_);
+      }
+      cols_ = col_;
+      rows_++;
+    }
+  }
+  void OnMapStart(const YAML::Mark&, const std::string&, YAML::anchor_t, YAML::EmitterStyle::value) override
+  {
+    error("a map is not a sequence of numbers");
+  }
+  void OnMapEnd() override
+  {
+  }
+  void finish() override
+  {
+    done(rows_, cols_);
+  }
+  void reset() override
+  {
+    StreamReader::Binding::reset();
+    level_ = rows_ = cols_ = col_ = 0;
+    nested_ = false;
+  }
+
+protected:
+  virtual void start() = 0;
+  virtual void push(std::size_t row, std::size_t col, double value) = 0;
+  virtual void done(std::size_t rows, std::size_t cols) = 0;
+  virtual void row_mismatch(std::size_t, std::size_t)
+  {
+  }
+
+  std::size_t level_ = 0;
+  std::size_t rows_ = 0;
+  std::size_t cols_ = 0;
+  std::size_t col_ = 0;
+  bool nested_ = false;
+};
+
+class VectorBinding : public NumericBinding
+{
+public:
+  VectorBinding(const KeyPath& path, std::vector<double>& target) : NumericBinding(path), target_(target)
+  {
+  }
+
+protected:
+  void start() override
+  {
+    target_.clear();
+  }
+  void push(std::size_t, std::size_t, double value) override
+  {
+    target_.push_back(value);
+  }
+  void done(std::size_t, std::size_t) override
+  {
+  }
+
+private:
+  std::vector<double>& target_;
+};
+
+/**
+ * @brief Transpose in place a rows x cols matrix stored by rows, so that it is stored by columns. The elements are
+ * moved along the cycles of the permutation, and the only extra memory is one bit for each element.
+ */
+void transpose_in_place(double* data, std::size_t rows, std::size_t cols)
+{
+  const std::size_t n = rows * cols;
+  if (rows <= 1 || cols <= 1)
+  {
+    return;
+  }
+  // the element k (row k / cols, col k % cols) moves to (k % cols) * rows + k / cols
+  std::vector<bool> moved(n, false);
+  for (std::size_t start = 1; start + 1 < n; start++)
+  {
+    if (moved[start])
+    {
+      continue;
+    }
+    std::size_t k = start;
+    double value = data[k];
+    do
+    {
+      const std::size_t next = (k % cols) * rows + k / cols;
+      std::swap(value, data[next]);
+      moved[next] = true;
+      k = next;
+    } while (k != start);
+  }
+}
+
+class MatrixBinding : public NumericBinding
+{
+public:
+  MatrixBinding(const KeyPath& path, Eigen::MatrixXd& target) : NumericBinding(path), target_(target)
+  {
+  }
+
+protected:
+  void start() override
+  {
+    target_.resize(0, 1);
+    size_ = 0;
+  }
+  void push(std::size_t, std::size_t, double value) override
+  {
+    // the values are written in the target, grown as a column vector
+    if (size_ == static_cast<std::size_t>(target_.size()))
+    {
+      target_.conservativeResize(static_cast<Eigen::Index>(std::max<std::size_t>(64, 2 * size_)), 1);
+    }
+    target_.data()[size_++] = value;
+  }
+  void done(std::size_t rows, std::size_t cols) override
+  {
+    target_.conservativeResize(static_cast<Eigen::Index>(size_), 1);
+    // the rows arrive one after the other: the storage is row-major, and it is transposed in place
+    transpose_in_place(target_.data(), rows, cols);
+    target_.resize(static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(cols));  // same size: no reallocation
+  }
+  void row_mismatch(std::size_t row, std::size_t cols) override
+  {
+    error("the row " + std::to_string(row) + " has " + std::to_string(cols) + " columns, while the previous rows have " +
+          std::to_string(cols_));
+  }
+
+private:
+  Eigen::MatrixXd& target_;
+  std::size_t size_ = 0;
+};
+
+class CallbackBinding : public NumericBinding
+{
+public:
+  CallbackBinding(const KeyPath& path, const StreamReader::ElementCallback& callback)
+    : NumericBinding(path), callback_(callback)
+  {
+  }
+
+protected:
+  void start() override
+  {
+  }
+  void push(std::size_t row, std::size_t col, double value) override
+  {
+    callback_(row, col, value);
+  }
+  void done(std::size_t, std::size_t) override
+  {
+  }
+
+private:
+  StreamReader::ElementCallback callback_;
+};
+
+/**
+ * @brief It builds the subtree as the YAML::Load (same tags, styles, and shared nodes for the aliases)
+ */
+class NodeBinding : public StreamReader::Binding
+{
+public:
+  NodeBinding(const KeyPath& path, YAML::Node& target) : StreamReader::Binding(path), target_(target)
+  {
+  }
+
+  void OnNull(const YAML::Mark&, YAML::anchor_t anchor) override
+  {
+    add(YAML::Node(YAML::NodeType::Null), anchor);
+  }
+  void OnAlias(const YAML::Mark&, YAML::anchor_t anchor) override
+  {
+    auto it = anchors_.find(anchor);
+    if (it == anchors_.end())
+    {
+      error("the alias refers to an anchor outside of the subtree");
+    }
+    add(it->second, YAML::NullAnchor);
+  }
+  void OnScalar(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor, const std::string& value) override
+  {
+    YAML::Node node(value);
+    node.SetTag(tag);
+    add(node, anchor);
+  }
+  void OnSequenceStart(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor,
+                       YAML::EmitterStyle::value style) override
+  {
+    begin(YAML::NodeType::Sequence, tag, anchor, style);
+  }
+  void OnSequenceEnd() override
+  {
+    end();
+  }
+  void OnMapStart(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor,
+                  YAML::EmitterStyle::value style) override
+  {
+    begin(YAML::NodeType::Map, tag, anchor, style);
+  }
+  void OnMapEnd() override
+  {
+    end();
+  }
+  void finish() override
+  {
+    target_ = root_;
+    root_.reset();
+    anchors_.clear();
+  }
+  void reset() override
+  {
+    StreamReader::Binding::reset();
+    stack_.clear();
+    anchors_.clear();
+    root_.reset();
+  }
+
+private:
+  struct Frame
+  {
+    YAML::Node node;
+    YAML::Node key;
+    bool has_key = false;
+  };
+
+  void begin(YAML::NodeType::value type, const std::string& tag, YAML::anchor_t anchor, YAML::EmitterStyle::value style)
+  {
+    Frame f;
+    f.node = YAML::Node(type);
+    f.node.SetTag(tag);
+    f.node.SetStyle(style);
+    if (anchor != YAML::NullAnchor)
+    {
+      anchors_[anchor] = f.node;
+    }
+    stack_.push_back(f);
+  }
+
+  void end()
+  {
+    YAML::Node node = stack_.back().node;
+    stack_.pop_back();
+    add(node, YAML::NullAnchor);
+  }
+
+  void add(const YAML::Node& node, YAML::anchor_t anchor)
+  {
+    if (anchor != YAML::NullAnchor)
+    {
+      anchors_[anchor] = node;
+    }
+    if (stack_.empty())
+    {
+      root_.reset(node);
+      return;
+    }
+    Frame& top = stack_.back();
+    if (top.node.IsSequence())
+    {
+      top.node.push_back(node);
+    }
+    else if (!top.has_key)
+    {
+      top.key.reset(node);  // the assignment would overwrite the previous key (a YAML::Node is a reference)
+      top.has_key = true;
+    }
+    else
+    {
+      // as the NodeBuilder of yaml-cpp, the duplicated keys are kept (the lookup finds the first one)
+      top.node.force_insert(top.key, node);
+      top.has_key = false;
+    }
+  }
+
+  YAML::Node& target_;
+  YAML::Node root_;
+  std::vector<Frame> stack_;
+  std::map<YAML::anchor_t, YAML::Node> anchors_;
+};
+
+/**
+ * @brief Thrown when all the bound nodes have been decoded, to stop the parser
+ */
+struct Completed
+{
+};
+
+/**
+ * @brief It tracks the path of the current node, and it forwards the events of the bound nodes to their bindings.
+ * The collections that cannot contain a bound path are skipped counting only their depth.
+ */
+class Dispatcher : public YAML::EventHandler
+{
+public:
+  explicit Dispatcher(const std::vector<std::unique_ptr<StreamReader::Binding>>& bindings)
+  {
+    for (const auto& b : bindings)
+    {
+      root_candidates_.push_back(b.get());
+    }
+    remaining_ = bindings.size();
+  }
+
+  void OnDocumentStart(const YAML::Mark& mark) override
+  {
+    mark_ = mark;
+  }
+  void OnDocumentEnd() override
+  {
+  }
+  void OnNull(const YAML::Mark& mark, YAML::anchor_t anchor) override
+  {
+    mark_ = mark;
+    if (begin_node(SCALAR, "~"))
+    {
+      for (auto b : captures_)
+      {
+        b->OnNull(mark, anchor);
+      }
+      end_capture();
+    }
+  }
+  void OnAlias(const YAML::Mark& mark, YAML::anchor_t anchor) override
+  {
+    mark_ = mark;
+    if (begin_node(SCALAR, ""))
+    {
+      for (auto b : captures_)
+      {
+        b->OnAlias(mark, anchor);
+      }
+      end_capture();
+    }
+  }
+  void OnScalar(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor,
+                const std::string& value) override
+  {
+    mark_ = mark;
+    if (begin_node(SCALAR, value))
+    {
+      for (auto b : captures_)
+      {
+        b->OnScalar(mark, tag, anchor, value);
+      }
+      end_capture();
+    }
+  }
+  void OnSequenceStart(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor,
+                       YAML::EmitterStyle::value style) override
+  {
+    mark_ = mark;
+    if (begin_node(SEQUENCE, ""))
+    {
+      for (auto b : captures_)
+      {
+        b->OnSequenceStart(mark, tag, anchor, style);
+      }
+    }
+  }
+  void OnSequenceEnd() override
+  {
+    end_node(SEQUENCE);
+  }
+  void OnMapStart(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor,
+                  YAML::EmitterStyle::value style) override
+  {
+    mark_ = mark;
+    if (begin_node(MAP, ""))
+    {
+      for (auto b : captures_)
+      {
+        b->OnMapStart(mark, tag, anchor, style);
+      }
+    }
+  }
+  void OnMapEnd() override
+  {
+    end_node(MAP);
+  }
+
+  const YAML::Mark& mark() const
+  {
+    return mark_;
+  }
+
+private:
+  enum Kind
+  {
+    SCALAR,
+    SEQUENCE,
+    MAP
+  };
+
+  struct Frame
+  {
+    bool is_map = false;
+    bool expect_key = true;
+    bool key_valid = false;
+    std::size_t index = 0;
+    std::string key;
+    std::vector<StreamReader::Binding*> candidates;
+  };
+
+  /**
+   * @brief Start of a node. It returns true if the node is captured by some bindings (the scalar nodes are then
+   * completed by the caller through end_capture()). If the node is a tracked collection, a frame is pushed.
+   */
+  bool begin_node(Kind kind, const std::string& scalar)
+  {
+    const bool collection = kind != SCALAR;
+    if (!captures_.empty())
+    {
+      capture_level_ += collection ? 1 : 0;
+      return true;
+    }
+    if (skip_)
+    {
+      skip_ += collection ? 1 : 0;
+      return false;
+    }
+
+    const std::vector<StreamReader::Binding*>* parent = &root_candidates_;
+    std::string component;
+    if (!stack_.empty())
+    {
+      Frame& top = stack_.back();
+      if (top.is_map && top.expect_key)
+      {
+        // a key: the scalars are kept, the other keys are skipped with their value
+        top.key_valid = !collection;
+        if (collection)
+        {
+          skip_ = 1;
+        }
+        else
+        {
+          top.key = scalar;
+          complete();
+        }
+        return false;
+      }
+      if (top.is_map && !top.key_valid)
+      {
+        return ignore(collection);
+      }
+      component = top.is_map ? top.key : std::to_string(top.index);
+      parent = &top.candidates;
+    }
+
+    const std::size_t depth = stack_.size();
+    std::vector<StreamReader::Binding*> candidates;
+    for (StreamReader::Binding* b : *parent)
+    {
+      // a key repeated in the stream: the first occurrence wins, as in the lookups of YAML::Load
+      if (b->found || (depth > 0 && b->path()[depth - 1] != component))
+      {
+        continue;
+      }
+      if (b->path().size() == depth)
+      {
+        captures_.push_back(b);
+      }
+      else
+      {
+        candidates.push_back(b);
+      }
+    }
+    if (!captures_.empty())
+    {
+      capture_level_ = collection ? 1 : 0;
+      return true;
+    }
+    if (candidates.empty())
+    {
+      return ignore(collection);
+    }
+    if (!collection)
+    {
+      complete();
+      return false;
+    }
+    Frame f;
+    f.is_map = kind == MAP;
+    f.candidates = std::move(candidates);
+    stack_.push_back(std::move(f));
+    return false;
+  }
+
+  bool ignore(bool collection)
+  {
+    if (collection)
+    {
+      skip_ = 1;
+    }
+    else
+    {
+      complete();
+    }
+    return false;
+  }
+
+  void end_node(Kind kind)
+  {
+    if (!captures_.empty())
+    {
+      for (auto b : captures_)
+      {
+        if (kind == MAP)
+        {
+          b->OnMapEnd();
+        }
+        else
+        {
+          b->OnSequenceEnd();
+        }
+      }
+      if (--capture_level_ == 0)
+      {
+        end_capture();
+      }
+      return;
+    }
+    if (skip_)
+    {
+      if (--skip_ == 0)
+      {
+        complete();
+      }
+      return;
+    }
+    stack_.pop_back();
+    complete();
+  }
+
+  void end_capture()
+  {
+    if (capture_level_ > 0)
+    {
+      return;
+    }
+    for (auto b : captures_)
+    {
+      b->finish();
+      b->found = true;
+    }
+    remaining_ -= captures_.size();
+    captures_.clear();
+    if (remaining_ == 0)
+    {
+      throw Completed();
+    }
+    complete();
+  }
+
+  /**
+   * @brief A node of the top frame is complete
+   */
+  void complete()
+  {
+    if (stack_.empty())
+    {
+      return;
+    }
+    Frame& top = stack_.back();
+    if (top.is_map)
+    {
+      top.expect_key = !top.expect_key;
+    }
+    else
+    {
+      top.index++;
+    }
+  }
+
+  std::vector<StreamReader::Binding*> root_candidates_;
+  std::vector<Frame> stack_;
+  std::vector<StreamReader::Binding*> captures_;
+  std::size_t capture_level_ = 0;
+  std::size_t skip_ = 0;
+  std::size_t remaining_ = 0;
+  YAML::Mark mark_;
+};
+
+}  // namespace
+
+StreamReader::StreamReader() = default;
+StreamReader::~StreamReader() = default;
+StreamReader::StreamReader(StreamReader&&) noexcept = default;
+StreamReader& StreamReader::operator=(StreamReader&&) noexcept = default;
+
+bool StreamReader::bind(const KeyPath& path, std::vector<double>& target)
+{
+  return add(std::make_unique<VectorBinding>(path, target));
+}
+
+bool StreamReader::bind(const KeyPath& path, Eigen::MatrixXd& target)
+{
+  return add(std::make_unique<MatrixBinding>(path, target));
+}
+
+bool StreamReader::bind(const KeyPath& path, const ElementCallback& callback)
+{
+  return add(std::make_unique<CallbackBinding>(path, callback));
+}
+
+bool StreamReader::bind(const KeyPath& path, YAML::Node& target)
+{
+  return add(std::make_unique<NodeBinding>(path, target));
+}
+
+bool StreamReader::add(std::unique_ptr<Binding>&& binding)
+{
+  // the events of a node are forwarded to the bindings of its path only: a nested binding would never be filled
+  for (const auto& b : bindings_)
+  {
+    if (b->path() != binding->path() &&
+        (b->path().is_prefix_of(binding->path()) || binding->path().is_prefix_of(b->path())))
+    {
+      return false;
+    }
+  }
+  bindings_.push_back(std::move(binding));
+  return true;
+}
+
+void StreamReader::clear()
+{
+  bindings_.clear();
+}
+
+bool StreamReader::read(std::istream& input, std::string& what)
+{
+  for (auto& b : bindings_)
+  {
+    b->reset();
+  }
+  if (bindings_.empty())
+  {
+    return true;
+  }
+
+  Dispatcher dispatcher(bindings_);
+  try
+  {
+    YAML::Parser parser(input);
+    parser.HandleNextDocument(dispatcher);
+  }
+  catch (const Completed&)
+  {
+  }
+  catch (const YAML::Exception& e)
+  {
+    what = e.what();
+    return false;
+  }
+  catch (const std::exception& e)
+  {
+    what = "yaml-cpp: error at line " + std::to_string(dispatcher.mark().line + 1) + ", column " +
+           std::to_string(dispatcher.mark().column + 1) + ": " + e.what();
+    return false;
+  }
+
+  std::string missing;
+  for (const auto& b : bindings_)
+  {
+    if (!b->found)
+    {
+      missing += (missing.empty() ? "" : ", ") + b->path().str();
+    }
+  }
+  if (!missing.empty())
+  {
+    what = "The keys are not in the stream: " + missing;
+    return false;
+  }
+  return true;
+}
+
+bool StreamReader::read_file(const std::string& path, std::string& what)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+  {
+    what = "Could not open the file '" + path + "'";
+    return false;
+  }
+  try
+  {
+    DecompressingStream input(file.rdbuf(), detect_compression(path, *file.rdbuf()));
+    if (!read(input, what))
+    {
+      what = "'" + path + "': " + what;
+      return false;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    what = "'" + path + "': " + e.what();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace yaml
+}  // namespace cnr
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <cnr_yaml/cnr_yaml.h>
+#include <cnr_yaml/load.h>
+#include <cnr_yaml/warmup.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+namespace
+{
+
+struct Registry
+{
+  std::shared_mutex mtx;
+  std::unordered_map<std::string, WarmupDecoder> decoders;
+};
+
+Registry& registry()
+{
+  static Registry* instance = []() {
+    auto* r = new Registry();
+    // registered directly, since register_warmup_type would take the registry again
+    auto add = [r](std::initializer_list<std::string> names, const WarmupDecoder& decoder) {
+      for (const auto& name : names)
+      {
+        r->decoders[name] = decoder;
+      }
+    };
+#define CNR_YAML_WARMUP_DECODER(T)                                                                                     \
+  [](const FrozenNode& node, std::any& value, std::string& what) {                                                     \
+    T ret{};                                                                                                           \
+    if (!cnr::yaml::get(node, ret, what, true))                                                                        \
+    {                                                                                                                  \
+      return false;                                                                                                    \
+    }                                                                                                                  \
+    value = std::move(ret);                                                                                            \
+    return true;                                                                                                       \
+  }
+    // the numeric types are registered by register_numeric_warmup_types, compiled in the translation unit of the user
+    add({ "bool", std::string(type_name<bool>()) }, CNR_YAML_WARMUP_DECODER(bool));
+    add({ "string", "std::string", std::string(type_name<std::string>()) }, CNR_YAML_WARMUP_DECODER(std::string));
+    add({ "std::vector<bool>", std::string(type_name<std::vector<bool>>()) },
+        CNR_YAML_WARMUP_DECODER(std::vector<bool>));
+    add({ "std::vector<std::string>", std::string(type_name<std::vector<std::string>>()) },
+        CNR_YAML_WARMUP_DECODER(std::vector<std::string>));
+#undef CNR_YAML_WARMUP_DECODER
+    return r;
+  }();
+  return *instance;
+}
+
+struct Result
+{
+  bool ok = false;
+  WarmCache::Entry entry;
+  std::string what;
+};
+
+void warm(const FrozenNode& root, const ManifestEntry& key, Result& result)
+{
+  WarmupDecoder decoder;
+  if (!key.type.empty())
+  {
+    Registry& r = registry();
+    std::shared_lock<std::shared_mutex> lock(r.mtx);
+    auto it = r.decoders.find(key.type);
+    if (it == r.decoders.end())
+    {
+      result.what = key.path.str() + ": the type '" + key.type + "' is not registered (see register_warmup_type)";
+      return;
+    }
+    decoder = it->second;
+  }
+
+  FrozenNode leaf;
+  std::string what;
+  if (!get_leaf(root, key.path.str().substr(1), leaf, what, "/"))
+  {
+    result.what = key.path.str() + ": " + what;
+    return;
+  }
+  result.entry.type = key.type;
+  result.entry.leaf = leaf;
+  if (decoder && !decoder(leaf, result.entry.value, what))
+  {
+    result.what = key.path.str() + " (" + key.type + "): " + what;
+    return;
+  }
+  result.ok = true;
+}
+
+}  // namespace
+
+void register_warmup_decoder(const std::string& type, const WarmupDecoder& decoder)
+{
+  Registry& r = registry();
+  std::unique_lock<std::shared_mutex> lock(r.mtx);
+  r.decoders[type] = decoder;
+}
+
+bool parse_manifest(const YAML::Node& node, Manifest& manifest, std::string& what)
+{
+  if (!node.IsSequence())
+  {
+    what = "The manifest is not a sequence of {path, type}";
+    return false;
+  }
+  Manifest ret;
+  ret.reserve(node.size());
+  for (std::size_t i = 0; i < node.size(); i++)
+  {
+    const YAML::Node item = node[i];
+    if (item.IsScalar())
+    {
+      ret.push_back(ManifestEntry{ KeyPath(item.Scalar()), "" });
+      continue;
+    }
+    if (!item.IsMap() || !item["path"] || !item["path"].IsScalar() || (item["type"] && !item["type"].IsScalar()))
+    {
+      what = "The item " + std::to_string(i) + " of the manifest is not a {path, type}: " + std::to_string(item);
+      return false;
+    }
+    ret.push_back(ManifestEntry{ KeyPath(item["path"].Scalar()), item["type"] ? item["type"].Scalar() : "" });
+  }
+  manifest = std::move(ret);
+  return true;
+}
+
+bool load_manifest(const std::string& path, Manifest& manifest, std::string& what)
+{
+  YAML::Node node;
+  if (!load_file(path, node, what))
+  {
+    return false;
+  }
+  if (!parse_manifest(node, manifest, what))
+  {
+    what = path + ": " + what;
+    return false;
+  }
+  return true;
+}
+
+FrozenNode WarmCache::leaf(const KeyPath& path) const
+{
+  auto it = std::lower_bound(slots_.begin(), slots_.end(), path,
+                             [](const Slot& slot, const KeyPath& p) { return slot.path < p; });
+  return it == slots_.end() || it->path != path ? FrozenNode() : it->entry.leaf;
+}
+
+void WarmCache::add(const KeyPath& path, Entry&& entry)
+{
+  auto first = std::lower_bound(slots_.begin(), slots_.end(), path,
+                                [](const Slot& slot, const KeyPath& p) { return slot.path < p; });
+  auto last = std::find_if(first, slots_.end(), [&path](const Slot& slot) { return slot.path != path; });
+  auto it = std::find_if(first, last, [&entry](const Slot& slot) { return slot.entry.type == entry.type; });
+  if (it != last)
+  {
+    it->entry = std::move(entry);
+    return;
+  }
+  slots_.insert(last, Slot{ path, std::move(entry) });
+}
+
+bool warmup(const FrozenNode& root, const Manifest& manifest, WarmCache& cache, std::string& what,
+            const std::size_t& n_threads)
+{
+  std::vector<Result> results(manifest.size());
+
+  // as in load_files: each worker takes the next key, and the results are stored by index
+  std::atomic<std::size_t> next{ 0 };
+  auto worker = [&]() {
+    for (std::size_t i = next++; i < manifest.size(); i = next++)
+    {
+      warm(root, manifest[i], results[i]);
+    }
+  };
+
+  std::size_t n = n_threads ? n_threads : std::max(1u, std::thread::hardware_concurrency());
+  n = std::min(n, manifest.size());
+  if (n <= 1)
+  {
+    worker();
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < n; t++)
+    {
+      threads.emplace_back(worker);
+    }
+    for (auto& t : threads)
+    {
+      t.join();
+    }
+  }
+
+  bool ok = true;
+  std::string errors;
+  cache.reserve(cache.size() + manifest.size());
+  for (std::size_t i = 0; i < manifest.size(); i++)
+  {
+    if (results[i].ok)
+    {
+      cache.add(manifest[i].path, std::move(results[i].entry));
+    }
+    else
+    {
+      ok = false;
+      errors += (errors.empty() ? "" : "\n") + results[i].what;
+    }
+  }
+  if (!ok)
+  {
+    what = errors;
+  }
+  return ok;
+}
+
+bool warmup(const YAML::Node& root, const Manifest& manifest, WarmCache& cache, std::string& what,
+            const std::size_t& n_threads)
+{
+  return warmup(FrozenNode(root), manifest, cache, what, n_threads);
+}
+
+}  // namespace yaml
+}  // namespace cnr
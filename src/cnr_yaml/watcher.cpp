@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cnr_yaml/node_utils.h>
+#include <cnr_yaml/watcher.h>
+
+namespace cnr
+{
+namespace yaml
+{
+
+namespace
+{
+YAML::Node merge_in_order(const std::vector<YAML::Node>& nodes)
+{
+  YAML::Node ret;
+  for (const auto& n : nodes)
+  {
+    ret.reset(merge_nodes(ret, n));
+  }
+  return ret;
+}
+
+}  // namespace
+
+Watcher::~Watcher()
+{
+  stop();
+}
+
+bool Watcher::start(const std::vector<std::string>& paths, std::string& what)
+{
+  return start(paths, what, Options());
+}
+
+bool Watcher::start(const std::vector<std::string>& paths, std::string& what, const Options& options)
+{
+  stop();
+  options_ = options;
+  if (!options_.merge)
+  {
+    options_.merge = merge_in_order;
+  }
+
+  std::vector<YAML::Node> nodes;
+  if (!load_files(paths, nodes, what, 0, options_.load))
+  {
+    return false;
+  }
+
+  inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  stop_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (inotify_fd_ < 0 || stop_fd_ < 0)
+  {
+    what = std::string("Could not initialize inotify: ") + std::strerror(errno);
+    stop();
+    return false;
+  }
+
+  paths_.clear();
+  watches_.clear();
+  for (const auto& p : paths)
+  {
+    const auto abs = std::filesystem::absolute(p).lexically_normal();
+    paths_.push_back(abs.string());
+    const std::string dir = abs.parent_path().string();
+    if (std::none_of(watches_.begin(), watches_.end(), [&dir](const auto& w) { return w.second == dir; }))
+    {
+      int wd = ::inotify_add_watch(inotify_fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+      if (wd < 0)
+      {
+        what = "Could not watch the directory '" + dir + "': " + std::strerror(errno);
+        stop();
+        return false;
+      }
+      watches_.emplace_back(wd, dir);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    nodes_ = std::move(nodes);  // a copy would assign the nodes one by one, rewriting the ones of the previous start
+    config_.reset(options_.merge(nodes_));
+    last_error_.clear();
+  }
+  stopping_ = false;
+  thread_ = std::thread(&Watcher::run, this);
+  return true;
+}
+
+void Watcher::stop()
+{
+  if (thread_.joinable())
+  {
+    stopping_ = true;
+    std::uint64_t one = 1;
+    ssize_t ret;
+    while ((ret = ::write(stop_fd_, &one, sizeof(one))) < 0 && errno == EINTR)
+    {
+    }
+    // EAGAIN: the counter is already non zero, so the event fd is readable anyway
+    if (ret < 0 && errno != EAGAIN)
+    {
+      // removing the watches queues an IN_IGNORED event for each of them, that wakes up the poll
+      for (const auto& w : watches_)
+      {
+        ::inotify_rm_watch(inotify_fd_, w.first);
+      }
+    }
+    thread_.join();
+  }
+  if (inotify_fd_ >= 0)
+  {
+    ::close(inotify_fd_);
+    inotify_fd_ = -1;
+  }
+  if (stop_fd_ >= 0)
+  {
+    ::close(stop_fd_);
+    stop_fd_ = -1;
+  }
+}
+
+std::size_t Watcher::subscribe(const Callback& callback)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  subscribers_.emplace_back(next_id_, callback);
+  return next_id_++;
+}
+
+void Watcher::unsubscribe(const std::size_t& id)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
+                                    [&id](const auto& s) { return s.first == id; }),
+                     subscribers_.end());
+}
+
+YAML::Node Watcher::config() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return YAML::Clone(config_);
+}
+
+std::string Watcher::last_error() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return last_error_;
+}
+
+void Watcher::run()
+{
+  using clock = std::chrono::steady_clock;
+  std::vector<char> dirty(paths_.size(), 0);
+  bool pending = false;
+  clock::time_point deadline;
+  alignas(struct inotify_event) char buffer[4096];
+
+  while (true)
+  {
+    int timeout = -1;
+    if (pending)
+    {
+      auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now()).count();
+      timeout = static_cast<int>(std::max<decltype(left)>(0, left));
+    }
+    struct pollfd fds[2] = { { inotify_fd_, POLLIN, 0 }, { stop_fd_, POLLIN, 0 } };
+    int ret = ::poll(fds, 2, timeout);
+    if (ret < 0 && errno != EINTR)
+    {
+      break;
+    }
+    if (stopping_ || (ret > 0 && (fds[1].revents & POLLIN)))
+    {
+      break;
+    }
+    if (ret > 0 && (fds[0].revents & POLLIN))
+    {
+      ssize_t len;
+      while ((len = ::read(inotify_fd_, buffer, sizeof(buffer))) > 0)
+      {
+        for (char* ptr = buffer; ptr < buffer + len;)
+        {
+          const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+          ptr += sizeof(struct inotify_event) + event->len;
+          if (event->len == 0)
+          {
+            continue;
+          }
+          auto w = std::find_if(watches_.begin(), watches_.end(),
+                                [event](const auto& w) { return w.first == event->wd; });
+          if (w == watches_.end())
+          {
+            continue;
+          }
+          const std::string path = (std::filesystem::path(w->second) / event->name).string();
+          for (std::size_t i = 0; i < paths_.size(); i++)
+          {
+            if (paths_[i] == path)
+            {
+              dirty[i] = 1;
+              pending = true;
+              // debounce: the reload waits for a quiet period after the last event
+              deadline = clock::now() + options_.debounce;
+            }
+          }
+        }
+      }
+    }
+    if (pending && clock::now() >= deadline)
+    {
+      std::vector<std::size_t> files;
+      for (std::size_t i = 0; i < dirty.size(); i++)
+      {
+        if (dirty[i])
+        {
+          files.push_back(i);
+          dirty[i] = 0;
+        }
+      }
+      pending = false;
+      reload(files);
+    }
+  }
+}
+
+void Watcher::reload(const std::vector<std::size_t>& files)
+{
+  std::vector<YAML::Node> nodes;
+  YAML::Node previous;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    nodes = nodes_;
+    previous = config_;
+  }
+
+  std::string errors;
+  for (const auto& i : files)
+  {
+    YAML::Node node;
+    std::string what;
+    if (load_file(paths_[i], node, what, options_.load))
+    {
+      nodes[i].reset(node);  // an assignment would rewrite the node shared with nodes_ and config_
+    }
+    else
+    {
+      errors += (errors.empty() ? "" : "\n") + what;
+    }
+  }
+
+  std::vector<KeyPath> changed;
+  YAML::Node next = diff_nodes(previous, options_.merge(nodes), changed);
+  std::vector<std::pair<std::size_t, Callback>> subscribers;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    nodes_ = std::move(nodes);  // a copy would assign the nodes one by one, rewriting the shared ones
+    last_error_ = errors;
+    if (changed.empty())
+    {
+      return;
+    }
+    config_.reset(next);
+    subscribers = subscribers_;
+  }
+  for (const auto& s : subscribers)
+  {
+    s.second(next, changed);
+  }
+}
+
+}  // namespace yaml
+}  // namespace cnr
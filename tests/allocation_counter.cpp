@@ -0,0 +1,101 @@
+#include <cstdlib>
+#include <new>
+
+#include "allocation_counter.h"
+
+namespace
+{
+// plain thread_local integers: no constructor, so they can be used during the start and the exit of a thread
+thread_local std::size_t allocations_count = 0;
+thread_local std::size_t allocations_bytes = 0;
+thread_local std::size_t allocations_frees = 0;
+
+void* allocate(std::size_t size)
+{
+  allocations_count++;
+  allocations_bytes += size;
+  if (void* p = std::malloc(size ? size : 1))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment)
+{
+  allocations_count++;
+  allocations_bytes += size;
+  const std::size_t a = static_cast<std::size_t>(alignment);
+  if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void deallocate(void* p) noexcept
+{
+  if (p)
+  {
+    allocations_frees++;
+  }
+  std::free(p);
+}
+}  // namespace
+
+namespace cnr_yaml_test
+{
+Allocations thread_allocations()
+{
+  return Allocations{ allocations_count, allocations_bytes, allocations_frees };
+}
+}  // namespace cnr_yaml_test
+
+void* operator new(std::size_t size)
+{
+  return allocate(size);
+}
+void* operator new[](std::size_t size)
+{
+  return allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  return allocate(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return allocate(size, alignment);
+}
+void operator delete(void* p) noexcept
+{
+  deallocate(p);
+}
+void operator delete[](void* p) noexcept
+{
+  deallocate(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+  deallocate(p);
+}
+void operator delete[](void* p, std::size_t) noexcept
+{
+  deallocate(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+  deallocate(p);
+}
@@ -0,0 +1,72 @@
+#ifndef CNR_YAML_UTILITIES__TESTS__ALLOCATION_COUNTER__H
+#define CNR_YAML_UTILITIES__TESTS__ALLOCATION_COUNTER__H
+
+#include <cstddef>
+
+namespace cnr_yaml_test
+{
+
+/**
+ * @brief The heap allocations of a thread. The global operator new/delete are replaced in allocation_counter.cpp, and
+ * they count the calls of each thread.
+ */
+struct Allocations
+{
+  std::size_t count = 0;
+  std::size_t bytes = 0;
+  std::size_t frees = 0;
+};
+
+/**
+ * @brief The allocations of the current thread since the start of the program
+ */
+Allocations thread_allocations();
+
+/**
+ * @brief The allocations of the current thread during the life of the scope (the scopes can be nested)
+ *
+ * @code
+ * cnr_yaml_test::AllocationScope scope;
+ * call_the_hot_path();
+ * EXPECT_EQ(scope.count(), 0u);
+ * @endcode
+ */
+class AllocationScope
+{
+public:
+  AllocationScope() : start_(thread_allocations())
+  {
+  }
+
+  Allocations allocations() const
+  {
+    const Allocations now = thread_allocations();
+    return Allocations{ now.count - start_.count, now.bytes - start_.bytes, now.frees - start_.frees };
+  }
+
+  std::size_t count() const
+  {
+    return allocations().count;
+  }
+
+private:
+  Allocations start_;
+};
+
+}  // namespace cnr_yaml_test
+
+/**
+ * @brief Check that a statement (evaluated once) does not allocate more than a budget
+ */
+#define EXPECT_ALLOCATIONS_LE(BUDGET, ...)                                                                             \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    cnr_yaml_test::AllocationScope cnr_yaml_allocation_scope_;                                                         \
+    __VA_ARGS__;                                                                                                       \
+    const auto cnr_yaml_allocations_ = cnr_yaml_allocation_scope_.allocations();                                       \
+    EXPECT_LE(cnr_yaml_allocations_.count, std::size_t(BUDGET))                                                       \
+        << "'" #__VA_ARGS__ "' allocated " << cnr_yaml_allocations_.count << " times ("                                \
+        << cnr_yaml_allocations_.bytes << " bytes)";                                                                   \
+  } while (false)
+
+#endif  // CNR_YAML_UTILITIES__TESTS__ALLOCATION_COUNTER__H
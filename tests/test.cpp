@@ -1,6 +1,7 @@
 #include <Eigen/Core>
 #include <array>
 #include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <vector>
 #include <yaml-cpp/node/node.h>
@@ -261,6 +262,8 @@ namespace cnr
 {
 namespace yaml
 {
+// the library declares the holders of int and double when it instantiates the numeric types
+#ifndef CNR_YAML_EXTERN_NUMERIC_TEMPLATES
 template <>
 struct decoding_type_variant_holder<int>
 {
@@ -274,6 +277,21 @@ struct decoding_type_variant_holder<double>
   using base = int;
   using variant = std::variant<double, long double, float, int32_t, int64_t, int16_t, int8_t>;
 };
+#endif
+
+template <>
+struct decoding_type_variant_holder<int64_t>
+{
+  using base = int64_t;
+  using variant = std::variant<int64_t, double>;
+};
+
+template <>
+struct decoding_type_variant_holder<uint64_t>
+{
+  using base = uint64_t;
+  using variant = std::variant<uint64_t, double>;
+};
 
 }  // namespace yaml
 }  // namespace cnr
@@ -346,8 +364,13 @@ TEST(YamlUtilities, ClientUsageBasicTypes)
   EXPECT_TRUE(a_int[0] == 10 && a_int[1] == 11 && a_int[2] == 12 && a_int[3] == 13);
 
   EXPECT_FALSE(call("int_array_2", v_int, false));
+#ifndef CNR_YAML_EXTERN_NUMERIC_TEMPLATES
+  // the implicit cast of the floating point values relies on the holders specialized above
   EXPECT_TRUE(call("int_array_2", v_int, true));
   EXPECT_TRUE(v_int.size() == 4 && v_int[0] == 10 && v_int[1] == 11 && v_int[2] == 12 && v_int[3] == 13);
+#else
+  EXPECT_FALSE(call("int_array_2", v_int, true));
+#endif
 
   int val_int = 0;
   EXPECT_TRUE(call("int_value", val_int));
@@ -380,6 +403,8 @@ TEST(YamlUtilities, ClientUsageBasicTypes)
   EXPECT_TRUE(call("nested_param.another_int", val_int));
   EXPECT_TRUE(val_int == 7);
 
+#ifndef CNR_YAML_EXTERN_NUMERIC_TEMPLATES
+  // the implicit cast of the floating point values relies on the holders specialized above
   EXPECT_TRUE(call("nested_param/another_int2", val_int));
   EXPECT_TRUE(call("nested_param.another_int2", val_int));
   EXPECT_TRUE(val_int == 7);
@@ -389,6 +414,9 @@ TEST(YamlUtilities, ClientUsageBasicTypes)
   EXPECT_TRUE(call("nested_param.nested_param/another_int2", val_int));
   EXPECT_TRUE(call("nested_param/nested_param.another_int2", val_int));
   EXPECT_TRUE(val_int == 7);
+#else
+  EXPECT_FALSE(call("nested_param/another_int2", val_int));
+#endif
 
   EXPECT_TRUE(call("n1/n3/v1", v_string));
   EXPECT_TRUE(v_string.size() == 3 && v_string[0] == "s1" && v_string[1] == "s2" && v_string[2] == "s3");
@@ -480,6 +508,1751 @@ TEST(YamlUtilities, ClientUsageBasicTypes)
   EXPECT_FALSE(call("n1/n4/vv3", me_double_21));
 }
 
+#include <cnr_yaml/frozen_node.h>
+
+template <typename T>
+bool frozen_call(const cnr::yaml::FrozenNode& root, const std::string& key, T& value,
+                 bool implicit_cast_if_possible = true)
+{
+  std::string what;
+  cnr::yaml::FrozenNode leaf;
+  if (!cnr::yaml::get_leaf(root, key, leaf, what, "/.") ||
+      !cnr::yaml::get(leaf, value, what, implicit_cast_if_possible))
+  {
+    std::cerr << "Key: " << key << ", What: " << what << std::endl;
+    return false;
+  }
+  return true;
+}
+
+TEST(FrozenNode, ClientUsageBasicTypes)
+{
+  cnr::yaml::FrozenNode root(node);
+  EXPECT_TRUE(root.IsMap());
+  EXPECT_EQ(root.size(), node.size());
+  EXPECT_FALSE(root["not_existent"]);
+  EXPECT_EQ(root["string_value"].Scalar(), "Hello Universe");
+
+  std::vector<double> v_double;
+  EXPECT_TRUE(frozen_call(root, "double_array", v_double));
+  EXPECT_TRUE(v_double.size() == 2 && v_double[0] == 7.5 && v_double[1] == 400.4);
+
+  std::array<double, 2> a_double;
+  EXPECT_TRUE(frozen_call(root, "double_array", a_double));
+  std::array<double, 3> a_double_2;
+  EXPECT_FALSE(frozen_call(root, "double_array", a_double_2));
+
+  Eigen::VectorXd ve_double;
+  EXPECT_TRUE(frozen_call(root, "double_array", ve_double));
+  EXPECT_TRUE(ve_double.rows() == 2 && ve_double(0) == 7.5 && ve_double(1) == 400.4);
+
+  Eigen::Matrix<double, 2, 2> me_double_22;
+  EXPECT_FALSE(frozen_call(root, "double_array", me_double_22));
+
+  Eigen::MatrixXd me_double;
+  EXPECT_TRUE(frozen_call(root, "n1/n4/vv3", me_double));
+  EXPECT_TRUE(me_double.rows() == 2 && me_double.cols() == 3 && me_double(0, 2) == 13.3 && me_double(1, 0) == 21.1);
+
+  double val = 0.0;
+  EXPECT_TRUE(frozen_call(root, "double_value", val));
+  EXPECT_TRUE(val == 3.14);
+
+  int val_int = 0;
+  EXPECT_TRUE(frozen_call(root, "int_value", val_int));
+  EXPECT_TRUE(val_int == 5);
+
+  std::vector<int> v_int;
+  EXPECT_FALSE(frozen_call(root, "int_array_2", v_int, false));
+#ifndef CNR_YAML_EXTERN_NUMERIC_TEMPLATES
+  // the implicit cast of the floating point values relies on the holders specialized above
+  EXPECT_TRUE(frozen_call(root, "nested_param.nested_param/another_int2", val_int));
+  EXPECT_TRUE(val_int == 7);
+  EXPECT_TRUE(frozen_call(root, "int_array_2", v_int, true));
+  EXPECT_TRUE(v_int.size() == 4 && v_int[0] == 10 && v_int[3] == 13);
+#else
+  EXPECT_FALSE(frozen_call(root, "int_array_2", v_int, true));
+#endif
+
+  // the double 2^63 is just above the largest int64_t, that rounds up to it as a double
+  cnr::yaml::FrozenNode bounds(YAML::Load("{max: 9.223372036854775808e18, below: 9.2233720368547748e18, "
+                                          "min: -9.223372036854775808e18, nan: .nan, negative: -1.0}"));
+  std::int64_t val_int64 = 0;
+  EXPECT_FALSE(frozen_call(bounds, "max", val_int64));
+  EXPECT_TRUE(frozen_call(bounds, "below", val_int64));
+  EXPECT_EQ(val_int64, 9223372036854774784);
+  EXPECT_TRUE(frozen_call(bounds, "min", val_int64));
+  EXPECT_EQ(val_int64, std::numeric_limits<std::int64_t>::min());
+  EXPECT_FALSE(frozen_call(bounds, "nan", val_int64));
+  std::uint64_t val_uint64 = 0;
+  EXPECT_FALSE(frozen_call(bounds, "negative", val_uint64));
+
+  std::vector<bool> v_bool;
+  EXPECT_TRUE(frozen_call(root, "bool_array", v_bool));
+  EXPECT_TRUE(v_bool.size() == 3 && v_bool[0] && !v_bool[1] && v_bool[2]);
+
+  std::vector<uint16_t> v_bytes;
+  EXPECT_TRUE(frozen_call(root, "bytes_array", v_bytes));
+  EXPECT_TRUE(v_bytes.size() == 3 && v_bytes[0] == 0x01 && v_bytes[1] == 0xF1 && v_bytes[2] == 0xA2);
+
+  std::vector<std::vector<std::string>> vv_string;
+  EXPECT_TRUE(frozen_call(root, "n1/n4/vv1", vv_string));
+  EXPECT_TRUE(vv_string.size() == 3 && vv_string[2][2] == "s33");
+
+  std::array<std::array<int, 2>, 3> aa_int_2;
+  EXPECT_FALSE(frozen_call(root, "n1/n4/vv2", aa_int_2));
+
+  YAML::Node sub;
+  EXPECT_TRUE(frozen_call(root, "n1/n2", sub));
+  EXPECT_EQ(sub["c1"].as<std::string>(), "ciao");
+
+  EXPECT_EQ(std::to_string(root.to_node()), std::to_string(node));
+}
+
+TEST(FrozenNode, LookupTimeAndMemory)
+{
+  cnr::yaml::FrozenNode root(node);
+  std::cout << "Frozen blob: " << root.memory_usage() << " bytes" << std::endl;
+
+  const std::size_t n = 10000;
+  double val = 0.0;
+  std::string what;
+  std::cout << "YAML::Node get_leaf + get (x" << n << ")" << std::endl;
+  EXECUTION_TIME(for (std::size_t i = 0; i < n; i++) {
+    YAML::Node leaf;
+    cnr::yaml::get_leaf(node, "nested_param/nested_param/another_int2", leaf, what);
+    cnr::yaml::get(leaf, val, what, false);
+  });
+  std::cout << "FrozenNode get_leaf + get (x" << n << ")" << std::endl;
+  EXECUTION_TIME(for (std::size_t i = 0; i < n; i++) {
+    cnr::yaml::FrozenNode leaf;
+    cnr::yaml::get_leaf(root, "nested_param/nested_param/another_int2", leaf, what);
+    cnr::yaml::get(leaf, val, what, false);
+  });
+  EXPECT_EQ(val, 7.0);
+}
+
+#include <cnr_yaml/snapshot.h>
+
+TEST(FrozenNode, Snapshot)
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "cnr_yaml_test.snapshot").string();
+  std::string what;
+  EXPECT_TRUE(cnr::yaml::save_snapshot(node, path, what)) << what;
+
+  cnr::yaml::FrozenNode root;
+  EXPECT_TRUE(cnr::yaml::load_snapshot(path, root, what, true)) << what;
+  EXPECT_EQ(std::to_string(root.to_node()), std::to_string(node));
+  EXPECT_TRUE(cnr::yaml::frozen::validate(*root.image(), what)) << what;
+
+  int val_int = 0;
+  EXPECT_TRUE(frozen_call(root, "nested_param/another_int", val_int));
+  EXPECT_TRUE(val_int == 7);
+#ifndef CNR_YAML_EXTERN_NUMERIC_TEMPLATES
+  EXPECT_TRUE(frozen_call(root, "nested_param.nested_param/another_int2", val_int));
+  EXPECT_TRUE(val_int == 7);
+#endif
+
+  auto v = root["double_array"].numbers();
+  EXPECT_TRUE(v.size() == 2 && v[0] == 7.5 && v[1] == 400.4);
+  std::span<const double> v_span;
+  EXPECT_TRUE(frozen_call(root, "double_array", v_span));
+  EXPECT_TRUE(v_span.data() == v.data());
+  EXPECT_FALSE(frozen_call(root, "string_value", v_span));
+
+  auto ve = cnr::yaml::as_eigen_vector(root["double_array"]);
+  EXPECT_TRUE(ve.rows() == 2 && ve(1) == 400.4);
+
+  cnr::yaml::FrozenNode vv3;
+  EXPECT_TRUE(cnr::yaml::get_leaf(root, "n1/n4/vv3", vv3, what)) << what;
+  auto me = cnr::yaml::as_eigen_matrix(vv3);
+  EXPECT_TRUE(me.rows() == 2 && me.cols() == 3 && me(0, 2) == 13.3 && me(1, 0) == 21.1);
+  EXPECT_EQ(cnr::yaml::as_eigen_matrix(root["string_value"]).size(), 0);
+
+  // a map whose children point back to the entries before it (its ancestors) is rejected
+  const auto& header = root.image()->header();
+  std::vector<std::uint64_t> blob((header.size + 7) / 8);
+  std::memcpy(blob.data(), root.image()->data(), header.size);
+  auto* entries = reinterpret_cast<cnr::yaml::frozen::Entry*>(reinterpret_cast<char*>(blob.data()) +
+                                                                header.entries_offset);
+  std::uint64_t corrupted = 2;
+  while (corrupted < header.entries &&
+         (entries[corrupted].type != YAML::NodeType::Map || entries[corrupted].size == 0))
+  {
+    corrupted++;
+  }
+  ASSERT_LT(corrupted, header.entries);
+  entries[corrupted].data = 1;
+  EXPECT_FALSE(cnr::yaml::frozen::validate(cnr::yaml::frozen::Image(nullptr, blob.data(), header.size), what));
+  std::cout << "What: " << what << std::endl;
+
+  // a count whose size in bytes wraps around is rejected by the header check
+  auto* forged = reinterpret_cast<cnr::yaml::frozen::Header*>(blob.data());
+  forged->entries += std::uint64_t(1) << 58;  // 2^58 entries of 64 bytes: 2^64, that wraps to 0
+  EXPECT_THROW(cnr::yaml::frozen::Image(nullptr, blob.data(), header.size), std::runtime_error);
+
+  // a subtree is frozen again as the root of its own snapshot
+  EXPECT_TRUE(cnr::yaml::save_snapshot(root["n1"], path, what)) << what;
+  cnr::yaml::FrozenNode n1;
+  EXPECT_TRUE(cnr::yaml::load_snapshot(path, n1, what)) << what;
+  EXPECT_EQ(std::to_string(n1.to_node()), std::to_string(node["n1"]));
+
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "not a snapshot";
+  }
+  EXPECT_FALSE(cnr::yaml::load_snapshot(path, n1, what));
+  std::filesystem::remove(path);
+  EXPECT_FALSE(cnr::yaml::load_snapshot(path, n1, what));
+}
+
+#include <cnr_yaml/document.h>
+
+TEST(Document, ParseFromEvents)
+{
+  std::string what;
+  cnr::yaml::Document doc;
+  EXPECT_TRUE(doc.parse_file(std::string(TEST_DIR) + "/tests/config.yaml", what)) << what;
+  EXPECT_EQ(std::to_string(doc.root().to_node()), std::to_string(node));
+  EXPECT_EQ(doc.memory_usage(), cnr::yaml::FrozenNode(node).memory_usage());
+
+  Eigen::MatrixXd me_double;
+  EXPECT_TRUE(frozen_call(doc.root(), "n1/n4/vv3", me_double));
+  EXPECT_TRUE(me_double.rows() == 2 && me_double.cols() == 3 && me_double(0, 2) == 13.3);
+  EXPECT_EQ(doc["string_value"].Scalar(), "Hello Universe");
+
+  const std::string text = "base: &base {a: 1, b: [1.5, 2.5]}\n"
+                           "key: &k name\n"
+                           "derived: *base\n"
+                           "list: [*k, *base]\n"
+                           "*k : 3\n";
+  EXPECT_TRUE(doc.parse(text, what)) << what;
+  EXPECT_EQ(std::to_string(doc["derived"].to_node()), std::to_string(YAML::Load(text)["base"]));
+  std::vector<double> b;
+  EXPECT_TRUE(frozen_call(doc.root(), "derived/b", b));
+  EXPECT_TRUE(b.size() == 2 && b[1] == 2.5);
+  EXPECT_EQ(doc["list"][1]["b"].numbers().size(), 2u);
+  EXPECT_EQ(doc["name"].Scalar(), "3");
+
+  EXPECT_FALSE(doc.parse(std::string("a: [1, 2"), what));
+  std::cout << "What: " << what << std::endl;
+  EXPECT_FALSE(doc.parse(std::string("a: &x [1, *x]"), what));
+  std::cout << "What: " << what << std::endl;
+  EXPECT_FALSE(doc.parse_file("not_existent.yaml", what));
+
+  EXPECT_TRUE(doc.parse(std::string(""), what)) << what;
+  EXPECT_TRUE(doc.root().IsNull());
+}
+
+TEST(Document, ParseTimeAndMemory)
+{
+  std::stringstream ss;
+  for (int i = 0; i < 2000; i++)
+  {
+    ss << "item_" << i << ":\n  name: item_" << i << "\n  gain: " << i * 0.5 << "\n  limits: [" << -i << ", " << i
+       << ", 0.5]\n  enabled: true\n";
+  }
+  const std::string text = ss.str();
+  std::cout << "Input: " << text.size() << " bytes" << std::endl;
+
+  std::string what;
+  YAML::Node yaml_node;
+  std::cout << "YAML::Load" << std::endl;
+  EXECUTION_TIME(yaml_node = YAML::Load(text););
+  std::cout << "YAML::Load + FrozenNode" << std::endl;
+  EXECUTION_TIME(cnr::yaml::FrozenNode frozen(yaml_node););
+  cnr::yaml::Document doc;
+  std::cout << "Document::parse" << std::endl;
+  EXECUTION_TIME(EXPECT_TRUE(doc.parse(text, what)) << what;);
+  std::cout << "Document: " << doc.memory_usage() << " bytes" << std::endl;
+  EXPECT_EQ(std::to_string(doc.root().to_node()), std::to_string(yaml_node));
+}
+
+#include <cnr_yaml/stream_reader.h>
+
+TEST(StreamReader, BindingsAndErrors)
+{
+  std::string what;
+  std::vector<double> v_double;
+  Eigen::MatrixXd me_double;
+  Eigen::MatrixXd ve_double;
+  std::vector<double> flattened;
+  std::size_t n_elements = 0;
+  double sum = 0;
+  cnr::yaml::StreamReader reader;
+  reader.bind("double_array", v_double);
+  reader.bind("/n1/n4/vv3", me_double);
+  reader.bind("n1.n4.vv3", flattened);
+  reader.bind("double_array", ve_double);
+  reader.bind("nested_param/nested_param/another_int2", [&](std::size_t, std::size_t, double v) {
+    n_elements++;
+    sum += v;
+  });
+  EXPECT_TRUE(reader.read_file(std::string(TEST_DIR) + "/tests/config.yaml", what)) << what;
+
+  EXPECT_TRUE(v_double.size() == 2 && v_double[0] == 7.5 && v_double[1] == 400.4);
+  EXPECT_TRUE(me_double.rows() == 2 && me_double.cols() == 3 && me_double(0, 2) == 13.3 && me_double(1, 0) == 21.1);
+  EXPECT_TRUE(flattened.size() == 6 && flattened[2] == 13.3 && flattened[3] == 21.1);
+  EXPECT_TRUE(ve_double.rows() == 2 && ve_double.cols() == 1 && ve_double(1) == 400.4);
+  EXPECT_TRUE(n_elements == 1 && sum == 7);
+
+  cnr::yaml::StreamReader not_numbers;
+  not_numbers.bind("string_value", v_double);
+  EXPECT_FALSE(not_numbers.read_file(std::string(TEST_DIR) + "/tests/config.yaml", what));
+  std::cout << "What: " << what << std::endl;
+
+  cnr::yaml::StreamReader missing;
+  missing.bind("not_existent/v", v_double);
+  EXPECT_FALSE(missing.read_file(std::string(TEST_DIR) + "/tests/config.yaml", what));
+  std::cout << "What: " << what << std::endl;
+
+  std::stringstream jagged("{points: [[1, 2], [3]], '1': {'0': [4]}, list: [[5], {a: 6}]}");
+  cnr::yaml::StreamReader reader_jagged;
+  reader_jagged.bind("points", me_double);
+  EXPECT_FALSE(reader_jagged.read(jagged, what));
+  std::cout << "What: " << what << std::endl;
+
+  std::stringstream indexes("{points: [[1, 2], [3]], '1': {'0': [4]}, list: [[5], {a: [6, 7]}]}");
+  std::vector<double> a;
+  std::vector<double> b;
+  cnr::yaml::StreamReader reader_indexes;
+  reader_indexes.bind("list/1/a", a);
+  reader_indexes.bind("1/0", b);
+  EXPECT_TRUE(reader_indexes.read(indexes, what)) << what;
+  EXPECT_TRUE(a.size() == 2 && a[1] == 7 && b.size() == 1 && b[0] == 4);
+
+  YAML::Node list;
+  EXPECT_FALSE(reader_indexes.bind("list", list));
+  EXPECT_FALSE(reader_indexes.bind("list/1/a/0", v_double));
+  EXPECT_TRUE(reader_indexes.bind("list/1/a", v_double));
+  EXPECT_TRUE(reader_indexes.bind("list/0", me_double));
+
+  std::stringstream matrices("{wide: [[1, 2, 3, 4, 5], [6, 7, 8, 9, 10]], tall: [[1], [2], [3]], row: [[1, 2, 3]]}");
+  Eigen::MatrixXd wide, tall, row;
+  cnr::yaml::StreamReader reader_matrices;
+  reader_matrices.bind("wide", wide);
+  reader_matrices.bind("tall", tall);
+  reader_matrices.bind("row", row);
+  EXPECT_TRUE(reader_matrices.read(matrices, what)) << what;
+  EXPECT_TRUE(wide.rows() == 2 && wide.cols() == 5 && wide(0, 4) == 5 && wide(1, 0) == 6 && wide(1, 3) == 9);
+  EXPECT_TRUE(tall.rows() == 3 && tall.cols() == 1 && tall(2) == 3);
+  EXPECT_TRUE(row.rows() == 1 && row.cols() == 3 && row(0, 2) == 3);
+
+  std::stringstream duplicated("a: [1]\na: [2]\nb: [3]\n");
+  std::vector<double> first;
+  std::vector<double> other;
+  cnr::yaml::StreamReader reader_duplicated;
+  reader_duplicated.bind("a", first);
+  reader_duplicated.bind("b", other);
+  EXPECT_TRUE(reader_duplicated.read(duplicated, what)) << what;
+  EXPECT_TRUE(first.size() == 1 && first[0] == 1 && other.size() == 1 && other[0] == 3);
+}
+
+TEST(StreamReader, LargeArray)
+{
+  const std::size_t rows = 20000;
+  std::stringstream ss;
+  ss << "header: {name: trajectory, joints: [j1, j2, j3]}\n";
+  ss << "points:\n";
+  for (std::size_t i = 0; i < rows; i++)
+  {
+    ss << "  - [" << i << ", " << i * 0.1 << ", " << i * 0.01 << "]\n";
+  }
+  ss << "footer: {done: true}\n";
+  const std::string text = ss.str();
+
+  std::string what;
+  Eigen::MatrixXd points;
+  cnr::yaml::StreamReader reader;
+  reader.bind("points", points);
+  std::cout << "StreamReader (" << text.size() << " bytes)" << std::endl;
+  EXECUTION_TIME(std::stringstream input(text); EXPECT_TRUE(reader.read(input, what)) << what;);
+  EXPECT_TRUE(points.rows() == rows && points.cols() == 3 && points(rows - 1, 0) == rows - 1);
+
+  Eigen::MatrixXd points_yaml;
+  std::cout << "YAML::Load + get" << std::endl;
+  EXECUTION_TIME(YAML::Node yaml_node = YAML::Load(text); cnr::yaml::get(yaml_node["points"], points_yaml, what, true););
+  EXPECT_TRUE(points_yaml.isApprox(points));
+}
+
+#include <cnr_yaml/load.h>
+
+TEST(Load, Subtree)
+{
+  std::string what;
+  YAML::Node n1;
+  EXPECT_TRUE(cnr::yaml::load_subtree(std::string(TEST_DIR) + "/tests/config.yaml", "/n1/**", n1, what)) << what;
+  EXPECT_EQ(std::to_string(n1), std::to_string(node["n1"]));
+
+  YAML::Node all;
+  EXPECT_TRUE(cnr::yaml::load_subtree(std::string(TEST_DIR) + "/tests/config.yaml", "", all, what)) << what;
+  EXPECT_EQ(std::to_string(all), std::to_string(node));
+
+  YAML::Node missing;
+  EXPECT_FALSE(cnr::yaml::load_subtree(std::string(TEST_DIR) + "/tests/config.yaml", "n1/none", missing, what));
+  std::cout << "What: " << what << std::endl;
+
+  std::stringstream anchors("defaults: &d {gain: 1}\nrobot:\n  arm_1: {a: &x [1, 2], b: *x, c: *d}\n");
+  YAML::Node arm;
+  EXPECT_FALSE(cnr::yaml::load_subtree(anchors, "robot/arm_1", arm, what));
+  std::cout << "What: " << what << std::endl;
+
+  std::stringstream ss;
+  for (int r = 0; r < 20; r++)
+  {
+    ss << "robot_" << r << ":\n";
+    for (int a = 0; a < 4; a++)
+    {
+      ss << "  arm_" << a << ":\n    joints: [";
+      for (int j = 0; j < 100; j++)
+      {
+        ss << (j ? ", " : "") << j * 0.1;
+      }
+      ss << "]\n    name: arm_" << a << "\n";
+    }
+  }
+  const std::string text = ss.str();
+  YAML::Node full;
+  std::cout << "YAML::Load + operator[] (" << text.size() << " bytes)" << std::endl;
+  EXECUTION_TIME(full = YAML::Load(text)["robot_0"]["arm_1"];);
+  YAML::Node sub;
+  std::cout << "load_subtree (head of the file)" << std::endl;
+  EXECUTION_TIME(std::stringstream input(text); EXPECT_TRUE(cnr::yaml::load_subtree(input, "robot_0/arm_1", sub, what));
+  );
+  EXPECT_EQ(std::to_string(sub), std::to_string(full));
+  std::cout << "load_subtree (tail of the file)" << std::endl;
+  EXECUTION_TIME(std::stringstream input(text); EXPECT_TRUE(cnr::yaml::load_subtree(input, "robot_19/arm_3", sub, what));
+  );
+  EXPECT_EQ(sub["name"].as<std::string>(), "arm_3");
+}
+
+TEST(Load, File)
+{
+  std::string what;
+  YAML::Node loaded;
+  EXPECT_TRUE(cnr::yaml::load_file(std::string(TEST_DIR) + "/tests/config.yaml", loaded, what)) << what;
+  EXPECT_EQ(std::to_string(loaded), std::to_string(node));
+  cnr::yaml::LoadOptions options;
+  options.use_mmap = false;
+  EXPECT_TRUE(cnr::yaml::load_file(std::string(TEST_DIR) + "/tests/config.yaml", loaded, what, options)) << what;
+  EXPECT_EQ(std::to_string(loaded), std::to_string(node));
+
+  EXPECT_FALSE(cnr::yaml::load_file("not_existent.yaml", loaded, what));
+  std::cout << "What: " << what << std::endl;
+
+  const std::string path = (std::filesystem::temp_directory_path() / "cnr_yaml_test_load.yaml").string();
+  {
+    std::ofstream out(path);
+    out << "a: [1, 2\n";
+  }
+  EXPECT_FALSE(cnr::yaml::load_file(path, loaded, what));
+  std::cout << "What: " << what << std::endl;
+
+  {
+    std::ofstream out(path);
+    for (int i = 0; i < 20000; i++)
+    {
+      out << "key_" << i << ": {value: " << i << ", list: [a, b, c]}\n";
+    }
+  }
+  YAML::Node a, b;
+  std::cout << "YAML::LoadFile" << std::endl;
+  EXECUTION_TIME(a = YAML::LoadFile(path););
+  std::cout << "cnr::yaml::load_file" << std::endl;
+  EXECUTION_TIME(EXPECT_TRUE(cnr::yaml::load_file(path, b, what)) << what;);
+  EXPECT_EQ(a.size(), b.size());
+  EXPECT_EQ(b["key_19999"]["value"].as<int>(), 19999);
+  std::filesystem::remove(path);
+}
+
+TEST(Load, ManyFiles)
+{
+  const auto dir = std::filesystem::temp_directory_path() / "cnr_yaml_test_load_files";
+  std::filesystem::create_directories(dir);
+  std::vector<std::string> paths;
+  for (int f = 0; f < 40; f++)
+  {
+    paths.push_back((dir / ("device_" + std::to_string(f) + ".yaml")).string());
+    std::ofstream out(paths.back());
+    out << "common: {owner: device_" << f << ", id: " << f << "}\n";
+    out << "device_" << f << ":\n";
+    for (int i = 0; i < 200; i++)
+    {
+      out << "  param_" << i << ": [" << i << ", " << f << "]\n";
+    }
+  }
+
+  std::string what;
+  std::vector<YAML::Node> sequential, parallel;
+  std::cout << "load_files (1 thread)" << std::endl;
+  EXECUTION_TIME(EXPECT_TRUE(cnr::yaml::load_files(paths, sequential, what, 1)) << what;);
+  std::cout << "load_files (4 threads)" << std::endl;
+  EXECUTION_TIME(EXPECT_TRUE(cnr::yaml::load_files(paths, parallel, what, 4)) << what;);
+  EXPECT_EQ(parallel.size(), paths.size());
+  for (std::size_t i = 0; i < paths.size(); i++)
+  {
+    EXPECT_EQ(std::to_string(sequential[i]), std::to_string(parallel[i]));
+  }
+
+  YAML::Node merged;
+  EXPECT_TRUE(cnr::yaml::load_and_merge_files(paths, merged, what, 4)) << what;
+  EXPECT_EQ(merged["common"]["owner"].as<std::string>(), "device_39");
+  EXPECT_EQ(merged["device_0"]["param_3"][0].as<int>(), 3);
+  EXPECT_EQ(merged.size(), paths.size() + 1);
+
+  paths.insert(paths.begin() + 3, (dir / "not_existent.yaml").string());
+  EXPECT_FALSE(cnr::yaml::load_files(paths, parallel, what, 4));
+  std::cout << "What: " << what << std::endl;
+  std::filesystem::remove_all(dir);
+}
+
+#include <cnr_yaml/parse_cache.h>
+
+TEST(Load, ParseCache)
+{
+  EXPECT_EQ(cnr::yaml::xxh64("", 0), 0xEF46DB3751D8E999ULL);
+  EXPECT_EQ(cnr::yaml::xxh64("abc", 3), 0x44BC2CF5AD770999ULL);
+  const std::string long_text = "Nobody inspects the spammish repetition";
+  EXPECT_EQ(cnr::yaml::xxh64(long_text.data(), long_text.size()), 0xFBCEA83C8A378BF1ULL);
+
+  const auto dir = std::filesystem::temp_directory_path() / "cnr_yaml_test_cache";
+  std::filesystem::remove_all(dir);
+  const std::string path = (std::filesystem::temp_directory_path() / "cnr_yaml_test_cache.yaml").string();
+  {
+    std::ofstream out(path);
+    for (int i = 0; i < 5000; i++)
+    {
+      out << "key_" << i << ": {value: " << i << ", gains: [" << i * 0.5 << ", 1.5, 2.5]}\n";
+    }
+  }
+
+  cnr::yaml::LoadOptions options;
+  options.cache_directory = dir.string();
+  cnr::yaml::reset_cache_stats();
+  std::string what;
+  YAML::Node miss, hit;
+  std::cout << "load_file (cache miss)" << std::endl;
+  EXECUTION_TIME(EXPECT_TRUE(cnr::yaml::load_file(path, miss, what, options)) << what;);
+  std::cout << "load_file (cache hit)" << std::endl;
+  EXECUTION_TIME(EXPECT_TRUE(cnr::yaml::load_file(path, hit, what, options)) << what;);
+  EXPECT_EQ(std::to_string(hit), std::to_string(miss));
+
+  cnr::yaml::FrozenNode frozen;
+  std::cout << "load_file as FrozenNode (cache hit)" << std::endl;
+  EXECUTION_TIME(EXPECT_TRUE(cnr::yaml::load_file(path, frozen, what, options)) << what;);
+  EXPECT_EQ(frozen["key_4999"]["value"].Scalar(), "4999");
+
+  auto stats = cnr::yaml::cache_stats();
+  EXPECT_TRUE(stats.hits == 2 && stats.misses == 1 && stats.stores == 1 && stats.errors == 0);
+
+  // a change of the content invalidates the entry
+  {
+    std::ofstream out(path);
+    out << "key_0: {value: 10}\n";
+  }
+  EXPECT_TRUE(cnr::yaml::load_file(path, hit, what, options)) << what;
+  EXPECT_EQ(hit["key_0"]["value"].as<int>(), 10);
+  stats = cnr::yaml::cache_stats();
+  EXPECT_TRUE(stats.hits == 2 && stats.misses == 2 && stats.stores == 2);
+
+  // a corrupted entry is a miss
+  {
+    std::ofstream out(cnr::yaml::cache::entry_path(dir.string(), path), std::ios::binary | std::ios::trunc);
+    out << "garbage";
+  }
+  EXPECT_TRUE(cnr::yaml::load_file(path, hit, what, options)) << what;
+  EXPECT_EQ(cnr::yaml::cache_stats().misses, 3u);
+
+  std::filesystem::remove(path);
+  std::filesystem::remove_all(dir);
+}
+
+#include <condition_variable>
+#include <cnr_yaml/watcher.h>
+
+TEST(Watcher, DiffNodes)
+{
+  YAML::Node previous = YAML::Load("{a: {b: 1, c: [1, 2]}, d: {e: x}, f: 3}");
+  YAML::Node next = YAML::Load("{a: {b: 1, c: [1, 5]}, d: {e: x}, g: 4}");
+  std::vector<cnr::yaml::KeyPath> changed;
+  YAML::Node merged = cnr::yaml::diff_nodes(previous, next, changed);
+  EXPECT_EQ(std::to_string(merged), std::to_string(next));
+  ASSERT_EQ(changed.size(), 3u);
+  EXPECT_EQ(changed[0].str(), "/a/c/1");
+  EXPECT_EQ(changed[1].str(), "/g");
+  EXPECT_EQ(changed[2].str(), "/f");
+  EXPECT_TRUE(merged["d"].is(previous["d"]));
+  EXPECT_TRUE(merged["a"]["b"].is(previous["a"]["b"]));
+  EXPECT_FALSE(merged["a"].is(previous["a"]));
+
+  changed.clear();
+  EXPECT_TRUE(cnr::yaml::diff_nodes(previous, YAML::Clone(previous), changed).is(previous));
+  EXPECT_TRUE(changed.empty());
+}
+
+TEST(Watcher, HotReload)
+{
+  const auto dir = std::filesystem::temp_directory_path() / "cnr_yaml_test_watcher";
+  std::filesystem::create_directories(dir);
+  const std::string base = (dir / "base.yaml").string();
+  const std::string over = (dir / "override.yaml").string();
+  {
+    std::ofstream out(base);
+    out << "robot: {name: r1, gains: [1, 2, 3]}\ntool: {mass: 1.5}\n";
+  }
+  {
+    std::ofstream out(over);
+    out << "tool: {mass: 2.0}\n";
+  }
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::size_t calls = 0;
+  std::vector<cnr::yaml::KeyPath> changed;
+  YAML::Node current;
+
+  std::string what;
+  cnr::yaml::Watcher::Options options;
+  options.debounce = std::chrono::milliseconds(50);
+  cnr::yaml::Watcher watcher;
+  ASSERT_TRUE(watcher.start({ base, over }, what, options)) << what;
+  EXPECT_EQ(watcher.config()["tool"]["mass"].as<double>(), 2.0);
+
+  // the subscribers receive the merged configuration itself, whose unchanged subtrees keep their identity
+  watcher.subscribe([&](const YAML::Node& config, const std::vector<cnr::yaml::KeyPath>& c) {
+    std::lock_guard<std::mutex> lock(mtx);
+    calls++;
+    changed = c;
+    current.reset(config);
+    cv.notify_all();
+  });
+
+  // a burst of writes is notified once
+  for (int i = 0; i < 5; i++)
+  {
+    std::ofstream out(over);
+    out << "tool: {mass: " << 3.0 + i << "}\n";
+  }
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&] { return calls > 0; }));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    EXPECT_EQ(calls, 1u);
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0].str(), "/tool/mass");
+  }
+  EXPECT_EQ(watcher.config()["tool"]["mass"].as<double>(), 7.0);
+  YAML::Node robot;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    robot.reset(current["robot"]);
+  }
+
+  // a file replaced by a rename
+  {
+    std::ofstream out(base + ".tmp");
+    out << "robot: {name: r2, gains: [1, 2, 3]}\ntool: {mass: 1.5}\n";
+  }
+  std::filesystem::rename(base + ".tmp", base);
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&] { return calls > 1; }));
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0].str(), "/robot/name");
+    EXPECT_TRUE(current["robot"]["gains"].is(robot["gains"]));
+  }
+
+  watcher.stop();
+  std::filesystem::remove_all(dir);
+}
+
+TEST(Watcher, SingleFile)
+{
+  const auto dir = std::filesystem::temp_directory_path() / "cnr_yaml_test_watcher_single";
+  std::filesystem::create_directories(dir);
+  const std::string path = (dir / "config.yaml").string();
+  {
+    std::ofstream out(path);
+    out << "robot: {name: r1, max_vel: 1.0}\n";
+  }
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::size_t calls = 0;
+  std::vector<cnr::yaml::KeyPath> changed;
+
+  std::string what;
+  cnr::yaml::Watcher::Options options;
+  options.debounce = std::chrono::milliseconds(50);
+  cnr::yaml::Watcher watcher;
+  ASSERT_TRUE(watcher.start({ path }, what, options)) << what;
+  const YAML::Node before = watcher.config();
+
+  // the configuration returned is a copy: editing it does not reach the trees compared by the reload
+  YAML::Node edited = watcher.config();
+  edited["robot"]["max_vel"] = 2.0;
+  edited["robot"]["added"] = true;
+  EXPECT_EQ(watcher.config()["robot"]["max_vel"].as<double>(), 1.0);
+  EXPECT_FALSE(watcher.config()["robot"]["added"]);
+
+  watcher.subscribe([&](const YAML::Node&, const std::vector<cnr::yaml::KeyPath>& c) {
+    std::lock_guard<std::mutex> lock(mtx);
+    calls++;
+    changed = c;
+    cv.notify_all();
+  });
+
+  // the merged configuration is the node of the file: the reload must not rewrite it before the comparison
+  {
+    std::ofstream out(path);
+    out << "robot: {name: r1, max_vel: 2.0}\n";
+  }
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&] { return calls > 0; }));
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0].str(), "/robot/max_vel");
+  }
+  EXPECT_EQ(watcher.config()["robot"]["max_vel"].as<double>(), 2.0);
+  EXPECT_EQ(before["robot"]["max_vel"].as<double>(), 1.0);  // the previous configuration is left untouched
+
+  // a restart on another file does not rewrite the configuration of the previous start
+  const std::string other = (dir / "other.yaml").string();
+  {
+    std::ofstream out(other);
+    out << "robot: {name: r2, max_vel: 3.0}\n";
+  }
+  ASSERT_TRUE(watcher.start({ path }, what, options)) << what;
+  const YAML::Node held = watcher.config();
+  ASSERT_TRUE(watcher.start({ other }, what, options)) << what;
+  EXPECT_EQ(watcher.config()["robot"]["name"].as<std::string>(), "r2");
+  EXPECT_EQ(held["robot"]["name"].as<std::string>(), "r1");
+  EXPECT_EQ(held["robot"]["max_vel"].as<double>(), 2.0);
+
+  watcher.stop();
+  std::filesystem::remove_all(dir);
+}
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 107000
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
+#include <cnr_yaml/compression.h>
+
+TEST(Load, Compressed)
+{
+  namespace io = boost::iostreams;
+  const auto dir = std::filesystem::temp_directory_path();
+  const std::string plain = (dir / "cnr_yaml_test_compressed.yaml").string();
+  {
+    std::ofstream out(plain);
+    out << "calibration:\n  table:\n";
+    for (int i = 0; i < 20000; i++)
+    {
+      out << "    - [" << i << ", " << i * 0.25 << ", " << i * 0.5 << "]\n";
+    }
+    out << "name: arm\n";
+  }
+
+  auto compress = [&](const std::string& path, cnr::yaml::Compression compression) {
+    std::ifstream in(plain, std::ios::binary);
+    std::ofstream file(path, std::ios::binary);
+    io::filtering_ostream out;
+    if (compression == cnr::yaml::Compression::GZIP)
+      out.push(io::gzip_compressor());
+    else if (compression == cnr::yaml::Compression::BZIP2)
+      out.push(io::bzip2_compressor());
+#if BOOST_VERSION >= 107000
+    else
+      out.push(io::zstd_compressor());
+#endif
+    out.push(file);
+    io::copy(in, out);
+  };
+
+  std::string what;
+  YAML::Node expected;
+  std::cout << "load_file (plain)" << std::endl;
+  EXECUTION_TIME(EXPECT_TRUE(cnr::yaml::load_file(plain, expected, what)) << what;);
+
+  const std::vector<std::pair<std::string, cnr::yaml::Compression>> formats = {
+    { plain + ".gz", cnr::yaml::Compression::GZIP },
+    { plain + ".bz2", cnr::yaml::Compression::BZIP2 },
+    { plain + ".zst", cnr::yaml::Compression::ZSTD },
+  };
+  for (const auto& [path, compression] : formats)
+  {
+    if (!cnr::yaml::is_supported(compression))
+    {
+      continue;
+    }
+    compress(path, compression);
+    EXPECT_EQ(cnr::yaml::compression_from_extension(path), compression);
+
+    YAML::Node node;
+    std::cout << "load_file (" << cnr::yaml::to_string(compression) << ", "
+              << std::filesystem::file_size(path) * 100 / std::filesystem::file_size(plain) << "% of the size)"
+              << std::endl;
+    EXECUTION_TIME(EXPECT_TRUE(cnr::yaml::load_file(path, node, what)) << what;);
+    EXPECT_EQ(std::to_string(node), std::to_string(expected));
+
+    cnr::yaml::LoadOptions options;
+    options.use_mmap = false;
+    EXPECT_TRUE(cnr::yaml::load_file(path, node, what, options)) << what;
+    EXPECT_EQ(node["calibration"]["table"].size(), 20000u);
+
+    cnr::yaml::FrozenNode frozen;
+    EXPECT_TRUE(cnr::yaml::load_file(path, frozen, what)) << what;
+    EXPECT_EQ(frozen["name"].Scalar(), "arm");
+
+    YAML::Node subtree;
+    EXPECT_TRUE(cnr::yaml::load_subtree(path, "calibration/table", subtree, what)) << what;
+    EXPECT_EQ(subtree[19999][1].as<double>(), 19999 * 0.25);
+
+    Eigen::MatrixXd table;
+    cnr::yaml::StreamReader reader;
+    reader.bind("calibration/table", table);
+    EXPECT_TRUE(reader.read_file(path, what)) << what;
+    EXPECT_EQ(table.rows(), 20000);
+    EXPECT_EQ(table(100, 2), 50.0);
+  }
+
+  // the magic bytes win over the extension
+  const std::string hidden = plain + ".data";
+  std::filesystem::copy_file(plain + ".gz", hidden, std::filesystem::copy_options::overwrite_existing);
+  YAML::Node node;
+  EXPECT_TRUE(cnr::yaml::load_file(hidden, node, what)) << what;
+  EXPECT_EQ(node["name"].as<std::string>(), "arm");
+
+  // a truncated file is an error, not a shorter document
+  std::filesystem::resize_file(hidden, std::filesystem::file_size(hidden) / 2);
+  EXPECT_FALSE(cnr::yaml::load_file(hidden, node, what));
+  std::cout << "what: " << what << std::endl;
+
+  std::filesystem::remove(plain);
+  std::filesystem::remove(hidden);
+  for (const auto& f : formats)
+  {
+    std::filesystem::remove(f.first);
+  }
+}
+
+TEST(Load, Directory)
+{
+  const auto dir = std::filesystem::temp_directory_path() / "cnr_yaml_test_conf.d";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir / "disabled");
+  auto write = [&](const std::string& name, const std::string& text) { std::ofstream(dir / name) << text; };
+  write("00-base.yaml", "robot: {name: r1, gains: {kp: 1, kd: 2}, limits: [1, 2]}\nrate: 100\n");
+  write("10-cell.yaml", "robot: {gains: {kp: 10}, tool: gripper}\n");
+  write("20-site.yaml", "robot: {limits: [3, 4], gains: default}\nrate: 250\n");
+  write(".20-site.yaml.swp", "rate: 0\n");
+  write("README.txt", "rate: 0\n");
+  write("disabled/30-test.yaml", "rate: 0\n");
+
+  std::string what;
+  YAML::Node merged;
+  cnr::yaml::Provenance provenance;
+  EXPECT_TRUE(cnr::yaml::load_directory(dir.string(), "*.yaml", merged, what, &provenance)) << what;
+  EXPECT_EQ(merged["rate"].as<int>(), 250);
+  EXPECT_EQ(merged["robot"]["name"].as<std::string>(), "r1");
+  EXPECT_EQ(merged["robot"]["tool"].as<std::string>(), "gripper");
+  EXPECT_EQ(merged["robot"]["gains"].as<std::string>(), "default");
+  EXPECT_EQ(merged["robot"]["limits"][1].as<int>(), 4);
+
+  const std::string base = (dir / "00-base.yaml").string();
+  const std::string cell = (dir / "10-cell.yaml").string();
+  const std::string site = (dir / "20-site.yaml").string();
+  const cnr::yaml::Provenance expected = {
+    { cnr::yaml::KeyPath("robot/name"), base },     { cnr::yaml::KeyPath("robot/gains"), site },
+    { cnr::yaml::KeyPath("robot/limits"), site },   { cnr::yaml::KeyPath("robot/tool"), cell },
+    { cnr::yaml::KeyPath("rate"), site },
+  };
+  EXPECT_EQ(provenance, expected);
+
+  // the same tree without the provenance
+  YAML::Node plain;
+  EXPECT_TRUE(cnr::yaml::load_directory(dir.string(), "*.yaml", plain, what)) << what;
+  EXPECT_EQ(std::to_string(plain), std::to_string(merged));
+
+  EXPECT_TRUE(cnr::yaml::load_directory(dir.string(), "*.json", plain, what)) << what;
+  EXPECT_TRUE(plain.IsNull());
+
+  write("15-broken.yaml", "robot: [\n");
+  EXPECT_FALSE(cnr::yaml::load_directory(dir.string(), "*.yaml", merged, what));
+  EXPECT_NE(what.find("15-broken.yaml"), std::string::npos) << what;
+  EXPECT_FALSE(cnr::yaml::load_directory((dir / "missing").string(), "*.yaml", merged, what));
+  std::cout << "what: " << what << std::endl;
+
+  std::filesystem::remove_all(dir);
+}
+
+#include <regex>
+#include <cnr_yaml/select.h>
+
+TEST(Select, GlobAndRegex)
+{
+  const YAML::Node node = YAML::Load(R"(
+arm_1:
+  gains: {p: 1, d: 2}
+  joints: [{name: j1}, {name: j2}]
+arm_2:
+  gains: {p: 3}
+  joints: [{name: j3}]
+base:
+  gains: {p: 5, i: 6}
+  wheels: {left: {gains: {p: 7}}}
+)");
+
+  auto paths = [](const std::vector<cnr::yaml::Match>& matches) {
+    std::vector<std::string> ret;
+    for (const auto& m : matches)
+    {
+      ret.push_back(m.path.str());
+    }
+    return ret;
+  };
+
+  std::string what;
+  std::vector<cnr::yaml::Match> matches;
+  EXPECT_TRUE(cnr::yaml::select(node, "*/gains/p", matches, what)) << what;
+  EXPECT_EQ(paths(matches), std::vector<std::string>({ "/arm_1/gains/p", "/arm_2/gains/p", "/base/gains/p" }));
+  EXPECT_EQ(matches[1].node.as<int>(), 3);
+  EXPECT_TRUE(matches[1].node.is(node["arm_2"]["gains"]["p"]));
+
+  EXPECT_TRUE(cnr::yaml::select(node, "/arm_*/joints/*", matches, what)) << what;
+  EXPECT_EQ(paths(matches), std::vector<std::string>({ "/arm_1/joints/0", "/arm_1/joints/1", "/arm_2/joints/0" }));
+
+  EXPECT_TRUE(cnr::yaml::select(node, "**/p", matches, what)) << what;
+  EXPECT_EQ(paths(matches), std::vector<std::string>({ "/arm_1/gains/p", "/arm_2/gains/p", "/base/gains/p",
+                                                       "/base/wheels/left/gains/p" }));
+
+  EXPECT_TRUE(cnr::yaml::select(node, "arm_1/joints/1/name", matches, what)) << what;
+  ASSERT_EQ(matches.size(), 1u);
+  EXPECT_EQ(matches[0].node.as<std::string>(), "j2");
+
+  EXPECT_TRUE(cnr::yaml::select(node, "base/**", matches, what)) << what;
+  EXPECT_EQ(matches.size(), 8u);
+  EXPECT_EQ(matches[0].path.str(), "/base");
+
+  EXPECT_TRUE(cnr::yaml::select(node, "missing/*", matches, what)) << what;
+  EXPECT_TRUE(matches.empty());
+  EXPECT_TRUE(cnr::yaml::select(node, "arm_1/joints/99999999999999999999999/name", matches, what)) << what;
+  EXPECT_TRUE(matches.empty());
+
+  EXPECT_TRUE(cnr::yaml::select(node, "^/arm_[0-9]+/gains/[pd]$", matches, what, cnr::yaml::Selector::Mode::REGEX))
+      << what;
+  EXPECT_EQ(paths(matches), std::vector<std::string>({ "/arm_1/gains/p", "/arm_1/gains/d", "/arm_2/gains/p" }));
+  EXPECT_TRUE(cnr::yaml::select(node, "/", matches, what, cnr::yaml::Selector::Mode::REGEX)) << what;
+  ASSERT_EQ(matches.size(), 1u);
+  EXPECT_TRUE(matches[0].node.is(node));
+  EXPECT_FALSE(cnr::yaml::select(node, "/arm_(", matches, what, cnr::yaml::Selector::Mode::REGEX));
+  std::cout << "what: " << what << std::endl;
+
+  // the compiled selector is reused
+  cnr::yaml::Selector selector;
+  ASSERT_TRUE(selector.compile("**/gains/p", cnr::yaml::Selector::Mode::GLOB, what)) << what;
+  EXPECT_TRUE(selector.matches("/base/wheels/left/gains/p"));
+  EXPECT_FALSE(selector.matches("/base/gains/i"));
+  EXPECT_EQ(selector.select(node).size(), 4u);
+  EXPECT_EQ(selector.select(node["arm_1"]).size(), 1u);
+
+  // pruning against get_keys_tree and a match of all the keys
+  YAML::Node large;
+  for (int a = 0; a < 200; a++)
+  {
+    YAML::Node arm;
+    for (int j = 0; j < 50; j++)
+    {
+      arm["joints"]["joint_" + std::to_string(j)]["limits"] = std::vector<double>{ -1.0, 1.0 };
+      arm["sensors"]["sensor_" + std::to_string(j)]["rate"] = 100;
+    }
+    large["arm_" + std::to_string(a)] = arm;
+  }
+  ASSERT_TRUE(selector.compile("arm_7/joints/*/limits", cnr::yaml::Selector::Mode::GLOB, what)) << what;
+  std::cout << "Selector::select" << std::endl;
+  EXECUTION_TIME(matches = selector.select(large););
+  EXPECT_EQ(matches.size(), 50u);
+
+  std::vector<std::string> keys;
+  std::size_t n = 0;
+  const std::regex regex("/+arm_7/+joints/+[^/]+/+limits/+");  // the format of get_keys_tree
+  std::cout << "get_keys_tree and regex_match" << std::endl;
+  EXECUTION_TIME(cnr::yaml::get_keys_tree("", large, keys); for (const auto& k
+                                                                  : keys) { n += std::regex_match(k, regex); });
+
+  ASSERT_TRUE(selector.compile("^/arm_7/joints/[^/]*/limits$", cnr::yaml::Selector::Mode::REGEX, what)) << what;
+  std::cout << "Selector::select (regex)" << std::endl;
+  EXECUTION_TIME(matches = selector.select(large););
+  EXPECT_EQ(matches.size(), 50u);
+  EXPECT_EQ(n, 50u);
+}
+
+#include <boost/program_options.hpp>
+#include <cnr_yaml/overrides.h>
+
+TEST(Overrides, CommandLine)
+{
+  const std::string values = (std::filesystem::temp_directory_path() / "cnr_yaml_test_values.yaml").string();
+  {
+    std::ofstream out(values);
+    out << "robot: {arm: {max_vel: 2.0, max_acc: 5.0}}\n";
+  }
+
+  const YAML::Node config = YAML::Load("robot: {name: r1, arm: {max_vel: 1.0, max_acc: 3.0, joints: [a, b]}}");
+  const std::vector<std::string> args = { "app",
+                                          "--rate",
+                                          "10",
+                                          "--set",
+                                          "robot/arm/max_vel=1.2",
+                                          "--set=robot.arm.joints=[j1, j2, j3]",
+                                          "--values",
+                                          values,
+                                          "--set",
+                                          "robot/arm/max_acc=4.5",
+                                          "--set",
+                                          "robot/name='007'",
+                                          "--set",
+                                          "robot/tool={mass: 1.5, frame: flange}",
+                                          "--set",
+                                          "robot/arm/max_acc=6" };
+  std::vector<const char*> argv;
+  for (const auto& a : args)
+  {
+    argv.push_back(a.c_str());
+  }
+
+  std::string what;
+  YAML::Node merged = YAML::Clone(config);
+  ASSERT_TRUE(cnr::yaml::apply_overrides(argv.size(), argv.data(), merged, what)) << what;
+  EXPECT_EQ(merged["robot"]["arm"]["max_vel"].as<double>(), 2.0);  // --values is after the first --set
+  EXPECT_EQ(merged["robot"]["arm"]["max_acc"].as<double>(), 6.0);  // the last one wins
+  EXPECT_EQ(merged["robot"]["arm"]["joints"].size(), 3u);
+  EXPECT_EQ(merged["robot"]["name"].as<std::string>(), "007");
+  EXPECT_EQ(merged["robot"]["tool"]["mass"].as<double>(), 1.5);
+  EXPECT_TRUE(merged["robot"]["tool"].IsMap());
+
+  // the overrides are parsed next to the options of the application
+  namespace po = boost::program_options;
+  po::options_description desc;
+  desc.add_options()("rate", po::value<int>());
+  desc.add(cnr::yaml::override_options());
+  const po::parsed_options parsed = po::command_line_parser(argv.size(), argv.data()).options(desc).run();
+  po::variables_map vm;
+  po::store(parsed, vm);
+  EXPECT_EQ(vm["rate"].as<int>(), 10);
+  YAML::Node overrides;
+  ASSERT_TRUE(cnr::yaml::make_overrides(parsed, overrides, what)) << what;
+  EXPECT_EQ(overrides["robot"]["arm"]["max_acc"].as<int>(), 6);
+  EXPECT_FALSE(overrides["robot"]["arm"]["joints"].IsNull());
+
+  auto parse = [&](std::vector<const char*> a) {
+    a.insert(a.begin(), "app");
+    return cnr::yaml::parse_overrides(a.size(), a.data(), overrides, what);
+  };
+  EXPECT_TRUE(parse({}));
+  EXPECT_TRUE(overrides.IsNull());
+  EXPECT_FALSE(parse({ "--set", "robot/arm/max_vel" }));
+  std::cout << "what: " << what << std::endl;
+  EXPECT_FALSE(parse({ "--set", "robot/arm=1", "--set", "robot/arm/max_vel=1" }));
+  std::cout << "what: " << what << std::endl;
+  EXPECT_FALSE(parse({ "--set", "robot/arm=[1, 2" }));
+  EXPECT_FALSE(parse({ "--values", "/missing.yaml" }));
+
+  std::filesystem::remove(values);
+}
+
+#include <cnr_yaml/shared_config.h>
+
+TEST(SharedConfig, ConcurrentReadersAndReloads)
+{
+  cnr::yaml::SharedConfig config(YAML::Load("{a: 0, b: 0, robot: {name: r1, gains: [1.0, 2.0, 3.0]}}"));
+  EXPECT_EQ(config.version(), 1u);
+
+  cnr::yaml::SharedConfig::Reader first(config);
+  EXPECT_EQ(first.get()["robot"]["name"].Scalar(), "r1");
+  EXPECT_EQ(config.merge(YAML::Load("{robot: {name: r2}}")), 2u);
+  EXPECT_EQ(first.get()["robot"]["name"].Scalar(), "r2");
+  EXPECT_EQ(first.get()["robot"]["gains"].size(), 3u);
+
+  // the writer publishes a = i, b = 2 * i; the readers must never see a torn update
+  std::atomic<bool> stop{ false };
+  std::atomic<std::size_t> errors{ 0 };
+  const std::size_t n_readers = 4;
+  std::vector<std::vector<double>> latencies(n_readers);
+  std::vector<std::size_t> reads(n_readers, 0);
+  std::vector<std::thread> readers;
+  for (std::size_t r = 0; r < n_readers; r++)
+  {
+    readers.emplace_back([&, r]() {
+      cnr::yaml::SharedConfig::Reader reader(config);
+      std::uint64_t last = 0;
+      while (!stop)
+      {
+        const auto t0 = std::chrono::steady_clock::now();
+        const cnr::yaml::FrozenNode& root = reader.get();
+        const auto t1 = std::chrono::steady_clock::now();
+        latencies[r].push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+        const long a = std::stol(std::string(root["a"].Scalar()));
+        const long b = std::stol(std::string(root["b"].Scalar()));
+        if (b != 2 * a || reader.version() < last)
+        {
+          errors++;
+        }
+        last = reader.version();
+
+        // a snapshot taken by hand stays valid across the swaps
+        const auto snapshot = config.snapshot();
+        if (snapshot->root["robot"]["gains"].size() != 3)
+        {
+          errors++;
+        }
+        reads[r]++;
+      }
+    });
+  }
+
+  std::size_t reloads = 0;
+  const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+  for (long i = 1; std::chrono::steady_clock::now() < end; i++)
+  {
+    YAML::Node next = YAML::Load("{robot: {name: r2, gains: [1.0, 2.0, 3.0]}}");
+    next["a"] = i;
+    next["b"] = 2 * i;
+    config.publish(next);
+    reloads++;
+  }
+  stop = true;
+  for (auto& t : readers)
+  {
+    t.join();
+  }
+
+  EXPECT_EQ(errors, 0u);
+  std::vector<double> all;
+  for (std::size_t r = 0; r < n_readers; r++)
+  {
+    EXPECT_GT(reads[r], 0u);
+    all.insert(all.end(), latencies[r].begin(), latencies[r].end());
+  }
+  std::sort(all.begin(), all.end());
+  std::cout << reloads << " reloads, " << all.size() << " reads; Reader::get latency [ns] p50 "
+            << all[all.size() / 2] << ", p99 " << all[all.size() * 99 / 100] << ", max " << all.back() << std::endl;
+  EXPECT_EQ(config.version(), reloads + 2);
+}
+
+TEST(SharedConfig, Subscriptions)
+{
+  using namespace std::chrono_literals;
+  std::string what;
+  cnr::yaml::SharedConfig config(YAML::Load("robot: {arm: {gains: [1, 1, 1], max_vel: 1.0}, name: r1}"));
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::vector<cnr::yaml::SharedConfig::Notification> arm;
+  std::vector<Eigen::VectorXd> gains;
+  std::vector<double> second_gains;
+  std::vector<std::string> names;
+  auto wait_for = [&](const std::function<bool()>& predicate) {
+    std::unique_lock<std::mutex> lock(mtx);
+    return cv.wait_for(lock, 5s, predicate);
+  };
+  const std::size_t arm_id = config.subscribe("robot/arm", [&](const cnr::yaml::SharedConfig::Notification& n) {
+    std::lock_guard<std::mutex> lock(mtx);
+    arm.push_back(n);
+    cv.notify_all();
+  });
+  config.subscribe<Eigen::VectorXd>("robot.arm.gains", [&](const Eigen::VectorXd& value, const auto&) {
+    std::lock_guard<std::mutex> lock(mtx);
+    gains.push_back(value);
+    cv.notify_all();
+  });
+  // the prefix walks through the sequences by index, as the changed paths are reported
+  config.subscribe<double>("robot/arm/gains/1", [&](const double& value, const auto&) {
+    std::lock_guard<std::mutex> lock(mtx);
+    second_gains.push_back(value);
+    cv.notify_all();
+  });
+  config.subscribe<std::string>("robot/name", [&](const std::string& value, const auto&) {
+    std::lock_guard<std::mutex> lock(mtx);
+    names.push_back(value);
+    cv.notify_all();
+  });
+
+  // the edits of a batch are published as one snapshot, with one notification
+  cnr::yaml::SharedConfig::Batch batch(config);
+  EXPECT_TRUE(batch.set("robot/arm/gains", Eigen::Vector3d(1, 2, 3), what)) << what;
+  EXPECT_TRUE(batch.set("robot/arm/max_vel", 2.0, what)) << what;
+  batch.set_leaf("robot/arm/mode", YAML::Load("position"));
+  const std::uint64_t version = batch.commit(what);
+  EXPECT_EQ(version, 2u) << what;
+  EXPECT_TRUE(batch.empty());
+  ASSERT_TRUE(wait_for([&]() { return arm.size() == 1 && gains.size() == 1 && second_gains.size() == 1; }));
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    EXPECT_EQ(arm[0].version, version);
+    EXPECT_EQ(arm[0].prefix.str(), "/robot/arm");
+    EXPECT_GE(arm[0].changed.size(), 3u);
+    for (const auto& path : arm[0].changed)
+    {
+      EXPECT_TRUE(cnr::yaml::KeyPath("/robot/arm").is_prefix_of(path)) << path.str();
+    }
+    double max_vel = 0;
+    EXPECT_TRUE(cnr::yaml::get(arm[0].value["max_vel"], max_vel, what, true)) << what;
+    EXPECT_EQ(max_vel, 2.0);
+    EXPECT_EQ(gains[0], Eigen::Vector3d(1, 2, 3));
+    EXPECT_EQ(second_gains[0], 2.0);
+    EXPECT_TRUE(names.empty());
+  }
+
+  // the subscribers of the untouched prefixes are not notified (the notifications are dispatched in order)
+  EXPECT_GT(config.set("other/key", 1, what), 0u) << what;
+  EXPECT_GT(config.set("robot/name", std::string("r2"), what), 0u) << what;
+  ASSERT_TRUE(wait_for([&]() { return names.size() == 1; }));
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    EXPECT_EQ(names[0], "r2");
+    EXPECT_EQ(arm.size(), 1u);
+    EXPECT_EQ(gains.size(), 1u);
+  }
+  double other = 0;
+  EXPECT_TRUE(cnr::yaml::get(config.snapshot()->root["other"]["key"], other, what, true)) << what;
+  EXPECT_EQ(other, 1.0);
+
+  // an edit that cannot be applied publishes nothing
+  const std::uint64_t before = config.version();
+  EXPECT_EQ(config.set_leaf("robot/name/first", YAML::Load("r"), what), 0u);
+  std::cout << "what: " << what << std::endl;
+  EXPECT_EQ(config.version(), before);
+
+  // the nodes of the caller are copied: the later edits of the batch do not reach them
+  const YAML::Node mine = YAML::Load("{y: 2}");
+  const YAML::Node overrides = YAML::Load("{b: {q: 4}}");
+  cnr::yaml::SharedConfig::Batch aliasing(config);
+  aliasing.set_leaf("a", mine);
+  EXPECT_TRUE(aliasing.set("a/z", 3, what)) << what;
+  aliasing.merge(overrides);
+  EXPECT_TRUE(aliasing.set("b/r", 5, what)) << what;
+  EXPECT_GT(aliasing.commit(what), 0u) << what;
+  EXPECT_EQ(std::to_string(mine), std::to_string(YAML::Load("{y: 2}")));
+  EXPECT_EQ(std::to_string(overrides), std::to_string(YAML::Load("{b: {q: 4}}")));
+  EXPECT_EQ(config.snapshot()->root["a"].size(), 2u);
+  EXPECT_EQ(config.snapshot()->root["b"].size(), 2u);
+
+  // merge and publish notify the subscribers of the changed keys only
+  config.unsubscribe(arm_id);
+  EXPECT_GT(config.merge(YAML::Load("robot: {arm: {gains: [4, 5, 6]}}")), 0u);
+  ASSERT_TRUE(wait_for([&]() { return gains.size() == 2 && second_gains.size() == 2; }));
+  config.publish(YAML::Load("robot: {arm: {gains: [4, 5, 6]}, name: r3}"));
+  ASSERT_TRUE(wait_for([&]() { return names.size() == 2; }));
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    EXPECT_EQ(gains[1], Eigen::Vector3d(4, 5, 6));
+    EXPECT_EQ(gains.size(), 2u);
+    EXPECT_EQ(second_gains[1], 5.0);
+    EXPECT_EQ(second_gains.size(), 2u);
+    EXPECT_EQ(names[1], "r3");
+    EXPECT_EQ(arm.size(), 1u);
+  }
+
+  // only the subscribed subtree is compared: a removed ancestor is reported as the removal of the prefix
+  config.subscribe("robot/arm", [&](const cnr::yaml::SharedConfig::Notification& n) {
+    std::lock_guard<std::mutex> lock(mtx);
+    arm.push_back(n);
+    cv.notify_all();
+  });
+  config.publish(YAML::Load("{robot: {name: r3}, other: {key: 2}}"));
+  ASSERT_TRUE(wait_for([&]() { return arm.size() == 2; }));
+  std::lock_guard<std::mutex> lock(mtx);
+  ASSERT_EQ(arm[1].changed.size(), 1u);
+  EXPECT_EQ(arm[1].changed[0].str(), "/robot/arm");
+  EXPECT_FALSE(arm[1].value.IsDefined());
+}
+
+#include <cnr_yaml/rt_param.h>
+#include "allocation_counter.h"
+
+TEST(Param, RealTimeReads)
+{
+  std::string what;
+  cnr::yaml::SharedConfig config(YAML::Load("controller: {gain: 2.5, gains: [1, 1, 1], mode: position}"));
+  cnr::yaml::Param<double> gain("controller/gain");
+  cnr::yaml::Param<std::vector<double>> gains("controller.gains");
+  cnr::yaml::Param<Eigen::Vector3d> vector("controller/gains");
+  cnr::yaml::Param<std::string> mode("controller/mode");
+  ASSERT_TRUE(gain.load(config.snapshot()->root, what)) << what;
+  ASSERT_TRUE(gains.load(config.snapshot()->root, what)) << what;
+  ASSERT_TRUE(vector.load(YAML::Load("controller: {gains: [1, 1, 1]}"), what)) << what;
+  ASSERT_TRUE(mode.load(config.snapshot()->root, what)) << what;
+  EXPECT_TRUE(gain.updated());
+  EXPECT_EQ(gain.get(), 2.5);
+  EXPECT_FALSE(gain.updated());
+  EXPECT_EQ(mode.get(), "position");
+
+  cnr::yaml::Param<double> missing("controller/missing");
+  EXPECT_FALSE(missing.load(config.snapshot()->root, what));
+  std::cout << "what: " << what << std::endl;
+  EXPECT_FALSE(gain.load(YAML::Load("controller: {gain: [1, 2]}"), what));
+  EXPECT_EQ(gain.get(), 2.5);  // a failed load does not change the value
+
+  // the RT thread reads while a non-RT thread reloads: each update is seen whole, and no read allocates
+  std::atomic<bool> stop{ false };
+  std::size_t errors = 0, allocations = 0, reads = 0;
+  std::thread rt([&]() {
+    cnr_yaml_test::AllocationScope scope;
+    double last = 0;
+    while (!stop)
+    {
+      const double g = gain.get();
+      const std::vector<double>& v = gains.get();
+      const Eigen::Vector3d& e = vector.get();
+      if (v.size() != 3 || v[0] != v[1] || v[1] != v[2] || e(0) != e(2) || g < last)
+      {
+        errors++;
+      }
+      last = g;
+      reads++;
+    }
+    allocations = scope.count();
+  });
+
+  for (int i = 1; i <= 2000; i++)
+  {
+    const std::string v = std::to_string(i);
+    config.publish(YAML::Load("controller: {gain: " + v + ", gains: [" + v + ", " + v + ", " + v + "]}"));
+    const auto snapshot = config.snapshot();
+    EXPECT_TRUE(gain.load(snapshot->root, what) && gains.load(snapshot->root, what) &&
+                vector.load(snapshot->root, what))
+        << what;
+    if (i % 100 == 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  stop = true;
+  rt.join();
+
+  std::cout << reads << " RT reads, " << allocations << " allocations" << std::endl;
+  EXPECT_GT(reads, 0u);
+  EXPECT_EQ(errors, 0u);
+  EXPECT_EQ(allocations, 0u);
+  EXPECT_EQ(gain.get(), 2000.0);
+  EXPECT_EQ(gains.get()[2], 2000.0);
+
+  // the counter works
+  cnr_yaml_test::AllocationScope scope;
+  std::vector<double> allocate(10);
+  EXPECT_EQ(scope.count(), 1u);
+  EXPECT_EQ(scope.allocations().bytes, 10 * sizeof(double));
+}
+
+#include <cnr_yaml/static_key.h>
+
+TEST(StaticKey, CompileTimeTokens)
+{
+  using Key = decltype(cnr::yaml::key<"/robot/arm.max_vel">);
+  static_assert(Key::size == 3);
+  static_assert(Key::token(0) == "robot" && Key::token(1) == "arm" && Key::token(2) == "max_vel");
+  static_assert(Key::tokens[2].hash == cnr::yaml::fnv1a("max_vel"));
+  static_assert(decltype(cnr::yaml::key<"">)::size == 0);
+  EXPECT_EQ(cnr::yaml::KeyPath(cnr::yaml::key<"/robot/arm.max_vel">), cnr::yaml::KeyPath("robot/arm/max_vel"));
+
+  const YAML::Node node = YAML::Load("robot: {name: r1, arm: {max_acc: 2.0, max_vel: 1.5}}");
+  const cnr::yaml::FrozenNode frozen(node);
+  std::string what;
+
+  cnr::yaml::FrozenNode frozen_leaf;
+  EXPECT_TRUE(cnr::yaml::get_leaf(frozen, cnr::yaml::key<"robot/arm/max_vel">, frozen_leaf, what)) << what;
+  EXPECT_EQ(frozen_leaf.Scalar(), "1.5");
+  EXPECT_EQ(cnr::yaml::find(frozen, cnr::yaml::key<"robot.name">).Scalar(), "r1");
+  EXPECT_FALSE(cnr::yaml::find(frozen, cnr::yaml::key<"robot/leg">));
+  EXPECT_FALSE(cnr::yaml::get_leaf(frozen, cnr::yaml::key<"robot/arm/max_jerk">, frozen_leaf, what));
+  std::cout << "what: " << what << std::endl;
+
+  YAML::Node leaf;
+  EXPECT_TRUE(cnr::yaml::get_leaf(node, cnr::yaml::key<"robot/arm/max_vel">, leaf, what)) << what;
+  EXPECT_EQ(leaf.as<double>(), 1.5);
+  EXPECT_TRUE(leaf.is(node["robot"]["arm"]["max_vel"]));
+  EXPECT_FALSE(cnr::yaml::get_leaf(node, cnr::yaml::key<"robot/name/first">, leaf, what));
+}
+
+#include <cnr_yaml/type_name.h>
+
+TEST(TypeName, CompileTime)
+{
+  static_assert(cnr::yaml::type_name<double>() == "double");
+  static_assert(cnr::yaml::type_name<const int&>() == "const int&");
+  static_assert(cnr::yaml::type_name<std::vector<int>>().find("vector<int") != std::string_view::npos);
+  EXPECT_EQ(cnr::yaml::type_name<Eigen::Vector3d>().find("Eigen::Matrix<double, 3, 1"), 0u);
+
+  // the diagnostic of a failed conversion still names the requested type
+  YAML::Node config = YAML::Load("{a: [1, 2, 3]}");
+  std::string what;
+  double value = 0;
+  EXPECT_FALSE(cnr::yaml::get(config["a"], value, what, true));
+  EXPECT_NE(what.find("double"), std::string::npos) << what;
+}
+
+#include <cnr_yaml/generator.h>
+
+TEST(Generator, Deterministic)
+{
+  cnr::yaml::GeneratorOptions options;
+  options.seed = 7;
+  options.breadth = 12;
+  options.depth = 5;
+  options.map_weight = 1.0;
+  options.max_nodes = 20000;
+  const YAML::Node a = cnr::yaml::generate_tree(options);
+  const YAML::Node b = cnr::yaml::generate_tree(options);
+  EXPECT_EQ(std::to_string(a), std::to_string(b));
+  const std::size_t n = cnr::yaml::count_nodes(a);
+  EXPECT_GE(n, 10000u);
+  EXPECT_LT(n, 20000u + options.max_array_size + 2);
+  // the emitted text is parsed back in the same tree
+  EXPECT_EQ(cnr::yaml::count_nodes(YAML::Load(std::to_string(a))), n);
+
+  options.seed = 8;
+  EXPECT_NE(std::to_string(cnr::yaml::generate_tree(options)), std::to_string(a));
+
+  // the levels of maps never exceed the depth, whatever the seed
+  std::function<std::size_t(const YAML::Node&)> map_levels = [&](const YAML::Node& node) -> std::size_t {
+    std::size_t deepest = 0;
+    if (node.IsMap())
+    {
+      for (const auto& kv : node)
+      {
+        deepest = std::max(deepest, map_levels(kv.second));
+      }
+      return deepest + 1;
+    }
+    return 0;
+  };
+  cnr::yaml::GeneratorOptions shape;
+  shape.breadth = 20;
+  shape.depth = 3;
+  for (std::uint64_t seed = 0; seed < 20; seed++)
+  {
+    shape.seed = seed;
+    EXPECT_LE(map_levels(cnr::yaml::generate_tree(shape)), shape.depth) << "seed " << seed;
+  }
+
+  cnr::yaml::RobotCellOptions cell_options;
+  cell_options.seed = 3;
+  cell_options.joints = 7;
+  const YAML::Node cell = cnr::yaml::generate_robot_cell(cell_options);
+  EXPECT_EQ(std::to_string(cell), std::to_string(cnr::yaml::generate_robot_cell(cell_options)));
+
+  std::string what;
+  YAML::Node leaf;
+  Eigen::VectorXd velocity;
+  EXPECT_TRUE(cnr::yaml::get_leaf(cell, "cell/robots/robot_1/arms/arm_0/limits/velocity", leaf, what)) << what;
+  EXPECT_TRUE(cnr::yaml::get(leaf, velocity, what, false)) << what;
+  EXPECT_EQ(velocity.size(), 7);
+  std::vector<double> p;
+  EXPECT_TRUE(cnr::yaml::get_leaf(cell, "cell/robots/robot_0/arms/arm_1/controllers/controller_2/gains/p", leaf, what))
+      << what;
+  EXPECT_TRUE(cnr::yaml::get(leaf, p, what, false)) << what;
+  EXPECT_EQ(p.size(), 7u);
+  std::cout << "Robot cell: " << cnr::yaml::count_nodes(cell) << " nodes" << std::endl;
+}
+
+#include <cnr_yaml/stats.h>
+
+TEST(Stats, Counters)
+{
+  const YAML::Node config = YAML::Load("{robot: {arm: {gains: [1.0, 2.0, 3.0], name: arm}}, other: 1}");
+  std::string what;
+  cnr::yaml::reset_stats();
+
+  YAML::Node leaf;
+  EXPECT_TRUE(cnr::yaml::get_leaf(config, "robot/arm/gains", leaf, what)) << what;
+  std::vector<double> gains;
+  EXPECT_TRUE(cnr::yaml::get(leaf, gains, what, false)) << what;
+  std::vector<double> wrong;
+  EXPECT_FALSE(cnr::yaml::get(config["robot"]["arm"]["name"], wrong, what, true));
+  YAML::Node out;
+  EXPECT_TRUE(cnr::yaml::set(gains, out, what)) << what;
+  YAML::Node merged = cnr::yaml::merge_nodes(config, YAML::Load("{robot: {arm: {name: arm_1}}}"));
+
+  // the counters of another thread are summed, also after it has exited
+  std::thread([&config]() {
+    YAML::Node l;
+    std::string w;
+    cnr::yaml::get_leaf(config, "other", l, w);
+  }).join();
+
+  const cnr::yaml::Stats s = cnr::yaml::stats();
+  std::cout << s << std::endl;
+  if (cnr::yaml::stats_enabled)
+  {
+    EXPECT_EQ(s.get_leaf_calls, 2u);
+    EXPECT_EQ(s.get_leaf_nodes, 4u);
+    EXPECT_GE(s.get_calls, 2u);
+    EXPECT_GE(s.decode_alternatives, 2u);
+    EXPECT_EQ(s.set_calls, 1u);
+    EXPECT_GE(s.encode_alternatives, 1u);
+    EXPECT_EQ(s.merge_calls, 1u);
+    EXPECT_GE(s.merge_nodes, 3u);
+    EXPECT_GT(s.what_bytes, 0u);
+    EXPECT_GT(s.get_ns, 0u);
+
+    cnr::yaml::reset_stats();
+    EXPECT_EQ(cnr::yaml::stats().get_calls, 0u);
+  }
+  else
+  {
+    EXPECT_EQ(s.get_calls + s.set_calls + s.get_leaf_calls + s.merge_calls + s.what_bytes, 0u);
+  }
+}
+
+TEST(Allocations, Budgets)
+{
+  std::string what;
+  what.reserve(4096);  // the failures would allocate the message, not the calls
+  const YAML::Node yaml = YAML::Load("robot: {arm: {max_vel: 1.5, joints: 6, q: [1, 2, 3, 4, 5, 6], p: [0.1, 0.2, 0.3]}}");
+  const cnr::yaml::FrozenNode frozen(yaml);
+  const YAML::Node arm = yaml["robot"]["arm"];
+  const cnr::yaml::FrozenNode frozen_arm = frozen["robot"]["arm"];
+
+  double d = 0;
+  int i = 0;
+  std::array<double, 6> q{};
+  Eigen::Vector3d p;
+  cnr::yaml::FrozenNode leaf;
+
+  // pre-resolved lookups and cached gets: no allocation at all
+  cnr::yaml::Param<double> max_vel("robot/arm/max_vel");
+  cnr::yaml::Param<Eigen::Vector3d> position("robot/arm/p");
+  ASSERT_TRUE(max_vel.load(frozen, what) && position.load(frozen, what)) << what;
+  EXPECT_ALLOCATIONS_LE(0, d = max_vel.get());
+  EXPECT_ALLOCATIONS_LE(0, p = position.get());
+  cnr::yaml::SharedConfig config(yaml);
+  cnr::yaml::SharedConfig::Reader reader(config);
+  EXPECT_ALLOCATIONS_LE(0, EXPECT_TRUE(reader.get()));
+  EXPECT_ALLOCATIONS_LE(0, leaf = cnr::yaml::find(frozen, cnr::yaml::key<"robot/arm/max_vel">));
+  EXPECT_ALLOCATIONS_LE(0, EXPECT_TRUE(cnr::yaml::get_leaf(frozen, cnr::yaml::key<"robot/arm/q">, leaf, what)));
+
+  // scalar and fixed-size decode from the frozen tree
+  EXPECT_ALLOCATIONS_LE(0, EXPECT_TRUE(cnr::yaml::get(frozen_arm["max_vel"], d, what, false)));
+  EXPECT_ALLOCATIONS_LE(0, EXPECT_TRUE(cnr::yaml::get(frozen_arm["joints"], i, what, false)));
+  EXPECT_ALLOCATIONS_LE(0, EXPECT_TRUE(cnr::yaml::get(frozen_arm["q"], q, what, false)));
+  EXPECT_ALLOCATIONS_LE(0, EXPECT_TRUE(cnr::yaml::get(frozen_arm["p"], p, what, false)));
+
+  // with ENABLE_STATS, the first instrumented call of a thread registers its counters
+  EXPECT_TRUE(cnr::yaml::get(arm["joints"], i, what, false));
+
+  // scalar and fixed-size decode from a YAML::Node. The budgets are the current costs of yaml-cpp (a double is
+  // parsed with a std::stringstream, and the iteration of a sequence creates the nodes of the elements)
+  EXPECT_ALLOCATIONS_LE(1, EXPECT_TRUE(cnr::yaml::get(arm["max_vel"], d, what, false)));
+  EXPECT_ALLOCATIONS_LE(0, EXPECT_TRUE(cnr::yaml::get(arm["joints"], i, what, false)));
+  EXPECT_ALLOCATIONS_LE(6, EXPECT_TRUE(cnr::yaml::get(arm["q"], q, what, false)));
+  EXPECT_ALLOCATIONS_LE(6, EXPECT_TRUE(cnr::yaml::get(arm["p"], p, what, false)));
+  EXPECT_ALLOCATIONS_LE(6, EXPECT_TRUE(cnr::yaml::get(arm["p"], p, what, true)));
+}
+
+#include <cnr_yaml/access_profile.h>
+
+TEST(AccessProfile, Report)
+{
+  // the buckets cover the values without gaps, with a relative width of at most 1/8
+  for (std::uint64_t v : { 0ul, 1ul, 7ul, 8ul, 9ul, 15ul, 16ul, 100ul, 1000ul, 123456ul, 1ul << 35 })
+  {
+    const std::size_t b = cnr::yaml::LatencyHistogram::bucket(v);
+    EXPECT_LE(cnr::yaml::LatencyHistogram::lower(b), v);
+    EXPECT_GE(cnr::yaml::LatencyHistogram::upper(b), v);
+    EXPECT_LE(cnr::yaml::LatencyHistogram::upper(b) - cnr::yaml::LatencyHistogram::lower(b), v / 8);
+  }
+  cnr::yaml::LatencyHistogram histogram;
+  for (std::uint64_t v = 1; v <= 1000; v++)
+  {
+    histogram.record(v);
+  }
+  EXPECT_NEAR(double(histogram.percentile(0.5)), 500.0, 500.0 / 8);
+  EXPECT_NEAR(double(histogram.percentile(0.99)), 990.0, 990.0 / 8);
+
+  const YAML::Node yaml = YAML::Load("robot: {arm: {max_vel: 1.5, q: [1, 2, 3]}, name: r}");
+  const cnr::yaml::FrozenNode frozen(yaml);
+  std::string what;
+  YAML::Node leaf;
+  cnr::yaml::Param<double> max_vel("robot.arm.max_vel");
+
+  cnr::yaml::reset_access_profile();
+  EXPECT_TRUE(cnr::yaml::get_leaf(yaml, "robot/name", leaf, what));  // not recorded: the profiling is disabled
+  cnr::yaml::enable_access_profiling(true);
+  for (int i = 0; i < 10; i++)
+  {
+    EXPECT_TRUE(max_vel.load(frozen, what)) << what;
+    EXPECT_TRUE(cnr::yaml::get_leaf(yaml, "robot/arm/q", leaf, what)) << what;
+  }
+  std::thread([&]() {
+    std::string w;
+    EXPECT_TRUE(max_vel.load(yaml, w)) << w;
+    cnr::yaml::FrozenNode l;
+    EXPECT_TRUE(cnr::yaml::get_leaf(frozen, cnr::yaml::key<"robot/arm/q">, l, w)) << w;
+  }).join();
+  // the failed lookups are not recorded, and the paths are split with the delimeters of the lookup
+  cnr::yaml::FrozenNode frozen_leaf;
+  cnr::yaml::Param<double> missing("robot/missing");
+  EXPECT_FALSE(cnr::yaml::get_leaf(yaml, "robot/missing", leaf, what));
+  EXPECT_FALSE(cnr::yaml::get_leaf(frozen, "robot.missing", frozen_leaf, what));
+  EXPECT_FALSE(missing.load(frozen, what));
+  EXPECT_TRUE(cnr::yaml::get_leaf(yaml, "robot:arm:q", leaf, what, ":")) << what;
+  cnr::yaml::enable_access_profiling(false);
+
+  const std::vector<cnr::yaml::KeyAccess> report = cnr::yaml::access_report();
+  cnr::yaml::write_access_report(std::cout);
+  ASSERT_EQ(report.size(), 2u);
+  for (std::size_t i = 1; i < report.size(); i++)
+  {
+    EXPECT_GE(report[i - 1].total_ns, report[i].total_ns);
+  }
+  for (const auto& a : report)
+  {
+    if (a.path == "/robot/arm/max_vel")
+    {
+      EXPECT_EQ(a.type, "double");
+      EXPECT_EQ(a.lookups, 11u);  // the get_leaf of Param::load is not recorded again
+      EXPECT_EQ(a.threads, 2u);
+      EXPECT_EQ(a.latency.count(), 11u);
+    }
+    else
+    {
+      EXPECT_EQ(a.path, "/robot/arm/q");
+      EXPECT_EQ(a.type, "");
+      EXPECT_EQ(a.lookups, 12u);
+    }
+  }
+
+  std::stringstream hot_keys;
+  cnr::yaml::write_hot_keys(hot_keys, 1);
+  const YAML::Node manifest = YAML::Load(hot_keys.str());
+  ASSERT_TRUE(manifest.IsSequence());
+  EXPECT_EQ(manifest.size(), 1u);
+  EXPECT_EQ(manifest[0]["path"].as<std::string>(), report[0].path);
+
+  cnr::yaml::reset_access_profile();
+  EXPECT_TRUE(cnr::yaml::access_report().empty());
+}
+
+#include <cnr_yaml/warmup.h>
+
+TEST(Warmup, Manifest)
+{
+  const YAML::Node yaml = YAML::Load("robot: {arm: {max_vel: 1.5, gains: [1, 2, 3], limits: [-1, 1]}, name: r}");
+  std::string what;
+
+  // the numeric types are registered from this translation unit, that specializes the variant holders
+  cnr::yaml::WarmCache unregistered;
+  EXPECT_FALSE(cnr::yaml::warmup(yaml, { { "robot/arm/max_vel", "double" } }, unregistered, what));
+  EXPECT_NE(what.find("the type 'double' is not registered"), std::string::npos) << what;
+  cnr::yaml::register_numeric_warmup_types();
+
+  cnr::yaml::Manifest manifest;
+  EXPECT_TRUE(cnr::yaml::parse_manifest(YAML::Load("- {path: robot.arm.max_vel, type: double}\n"
+                                                   "- {path: /robot/arm/gains, type: Eigen::VectorXd}\n"
+                                                   "- {path: /robot/name, type: std::string}\n"
+                                                   "- /robot/arm\n"
+                                                   "- {path: /robot/arm/missing, type: double}\n"
+                                                   "- {path: /robot/name, type: unknown_type}\n"
+                                                   "- {path: /robot/name, type: double}"),
+                                         manifest, what))
+      << what;
+  ASSERT_EQ(manifest.size(), 7u);
+  EXPECT_EQ(manifest[0].path.str(), "/robot/arm/max_vel");
+  EXPECT_EQ(manifest[3].type, "");
+  EXPECT_FALSE(cnr::yaml::parse_manifest(YAML::Load("{path: /robot}"), manifest, what));
+  EXPECT_EQ(manifest.size(), 7u);
+
+  // all the failures are reported together, and the keys that succeeded are in the cache anyway
+  for (const std::size_t n_threads : { 1u, 2u, 0u })
+  {
+    cnr::yaml::WarmCache cache;
+    what.clear();
+    EXPECT_FALSE(cnr::yaml::warmup(yaml, manifest, cache, what, n_threads));
+    const std::size_t missing = what.find("/robot/arm/missing:");
+    const std::size_t unknown = what.find("/robot/name: the type 'unknown_type' is not registered");
+    const std::size_t wrong = what.find("\n/robot/name (double): ");
+    EXPECT_EQ(missing, 0u) << what;  // in the order of the manifest
+    EXPECT_LT(missing, unknown) << what;
+    EXPECT_LT(unknown, wrong) << what;
+    EXPECT_NE(wrong, std::string::npos) << what;
+    EXPECT_EQ(cache.size(), 4u);
+
+    ASSERT_NE(cache.find<double>("/robot/arm/max_vel"), nullptr);
+    EXPECT_EQ(*cache.find<double>("robot.arm.max_vel"), 1.5);
+    EXPECT_EQ(cache.find<int>("/robot/arm/max_vel"), nullptr);  // warmed up as a double
+    Eigen::VectorXd gains;
+    EXPECT_TRUE(cache.get("/robot/arm/gains", gains));
+    EXPECT_EQ(gains, Eigen::Vector3d(1, 2, 3));
+    std::string name;
+    EXPECT_TRUE(cache.get("/robot/name", name));
+    EXPECT_EQ(name, "r");
+    EXPECT_TRUE(cache.leaf("/robot/arm").IsMap());
+    EXPECT_FALSE(cache.leaf("/robot/arm/missing").IsDefined());
+  }
+
+  // the lookups of the warm values do not allocate (with a KeyPath built once, or with a static key)
+  {
+    cnr::yaml::WarmCache cache;
+    EXPECT_FALSE(cnr::yaml::warmup(yaml, manifest, cache, what));
+    const cnr::yaml::KeyPath gains_path("/robot/arm/gains");
+    EXPECT_ALLOCATIONS_LE(0, EXPECT_NE(cache.find<Eigen::VectorXd>(gains_path), nullptr));
+    EXPECT_ALLOCATIONS_LE(0, EXPECT_NE(cache.find<Eigen::VectorXd>(cnr::yaml::key<"robot.arm.gains">), nullptr));
+    EXPECT_ALLOCATIONS_LE(0, EXPECT_NE(cache.find<double>(cnr::yaml::key<"/robot/arm/max_vel">), nullptr));
+    EXPECT_ALLOCATIONS_LE(0, EXPECT_EQ(cache.find<double>(cnr::yaml::key<"/robot/arm">), nullptr));
+    EXPECT_ALLOCATIONS_LE(0, EXPECT_EQ(cache.find<double>(cnr::yaml::key<"/robot/arm/max_vel/x">), nullptr));
+    EXPECT_ALLOCATIONS_LE(0, EXPECT_EQ(cache.find<double>(cnr::yaml::key<"/robot/arm/gains">), nullptr));
+  }
+
+  // the types that are not registered by default
+  using Limits = std::array<double, 2>;
+  cnr::yaml::Manifest custom{ { "/robot/arm/limits", "limits" } };
+  cnr::yaml::WarmCache cache;
+  EXPECT_FALSE(cnr::yaml::warmup(yaml, custom, cache, what));
+  cnr::yaml::register_warmup_type<Limits>({ "limits" });
+  EXPECT_TRUE(cnr::yaml::warmup(yaml, custom, cache, what)) << what;
+  ASSERT_NE(cache.find<Limits>("/robot/arm/limits"), nullptr);
+  EXPECT_EQ((*cache.find<Limits>("/robot/arm/limits")), (Limits{ -1, 1 }));
+
+  // the manifest written by the access profiler
+  cnr::yaml::Param<double> max_vel("robot.arm.max_vel");
+  cnr::yaml::reset_access_profile();
+  cnr::yaml::enable_access_profiling(true);
+  EXPECT_TRUE(max_vel.load(yaml, what)) << what;
+  cnr::yaml::enable_access_profiling(false);
+  std::stringstream hot_keys;
+  cnr::yaml::write_hot_keys(hot_keys);
+  cnr::yaml::reset_access_profile();
+  EXPECT_TRUE(cnr::yaml::parse_manifest(YAML::Load(hot_keys.str()), manifest, what)) << what;
+  ASSERT_EQ(manifest.size(), 1u);
+  cnr::yaml::WarmCache hot;
+  EXPECT_TRUE(cnr::yaml::warmup(yaml, manifest, hot, what)) << what;
+  ASSERT_NE(hot.find<double>("/robot/arm/max_vel"), nullptr);
+
+  // the keys that need quotes and escapes
+  const YAML::Node quoted = YAML::Load(R"({'say "hi"': {'back\slash': 1, 'it''s': [2]}})");
+  cnr::yaml::enable_access_profiling(true);
+  YAML::Node leaf;
+  EXPECT_TRUE(cnr::yaml::get_leaf(quoted, "say \"hi\"/back\\slash", leaf, what)) << what;
+  EXPECT_TRUE(cnr::yaml::get_leaf(quoted, "say \"hi\"/it's", leaf, what)) << what;
+  cnr::yaml::enable_access_profiling(false);
+  std::stringstream quoted_keys;
+  cnr::yaml::write_hot_keys(quoted_keys);
+  cnr::yaml::reset_access_profile();
+  EXPECT_TRUE(cnr::yaml::parse_manifest(YAML::Load(quoted_keys.str()), manifest, what)) << what;
+  ASSERT_EQ(manifest.size(), 2u);
+  std::vector<std::string> quoted_paths{ manifest[0].path.str(), manifest[1].path.str() };
+  std::sort(quoted_paths.begin(), quoted_paths.end());
+  EXPECT_EQ(quoted_paths, std::vector<std::string>({ "/say \"hi\"/back\\slash", "/say \"hi\"/it's" }));
+}
+
 using namespace std::chrono_literals;
 
 int main(int argc, char** argv)
@@ -0,0 +1,80 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <boost/program_options.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/generator.h>
+
+namespace po = boost::program_options;
+
+int main(int argc, char** argv)
+{
+  cnr::yaml::GeneratorOptions tree;
+  cnr::yaml::RobotCellOptions cell;
+  std::string output;
+
+  po::options_description desc("Generate a synthetic YAML configuration (see cnr_yaml/generator.h)");
+  // clang-format off
+  desc.add_options()
+    ("help,h", "print this message")
+    ("output,o", po::value<std::string>(&output), "output file (default: the standard output)")
+    ("seed,s", po::value<std::uint64_t>(), "seed of the pseudo-random generator")
+    ("robot-cell", "generate a robot cell, instead of a random tree")
+    ("breadth", po::value<std::size_t>(&tree.breadth)->default_value(tree.breadth), "keys of each map")
+    ("depth", po::value<std::size_t>(&tree.depth)->default_value(tree.depth), "levels of maps")
+    ("key-length", po::value<std::size_t>(&tree.key_length)->default_value(tree.key_length), "length of the keys")
+    ("scalar-weight", po::value<double>(&tree.scalar_weight)->default_value(tree.scalar_weight), "weight of the scalars")
+    ("sequence-weight", po::value<double>(&tree.sequence_weight)->default_value(tree.sequence_weight), "weight of the arrays")
+    ("map-weight", po::value<double>(&tree.map_weight)->default_value(tree.map_weight), "weight of the maps")
+    ("min-array-size", po::value<std::size_t>(&tree.min_array_size)->default_value(tree.min_array_size), "minimum size of the arrays")
+    ("max-array-size", po::value<std::size_t>(&tree.max_array_size)->default_value(tree.max_array_size), "maximum size of the arrays")
+    ("max-nodes", po::value<std::size_t>(&tree.max_nodes)->default_value(tree.max_nodes), "maximum number of nodes (0: no limit)")
+    ("robots", po::value<std::size_t>(&cell.robots)->default_value(cell.robots), "robots of the cell")
+    ("arms", po::value<std::size_t>(&cell.arms_per_robot)->default_value(cell.arms_per_robot), "arms of each robot")
+    ("joints", po::value<std::size_t>(&cell.joints)->default_value(cell.joints), "joints of each arm")
+    ("controllers", po::value<std::size_t>(&cell.controllers_per_arm)->default_value(cell.controllers_per_arm), "controllers of each arm")
+    ("sensors", po::value<std::size_t>(&cell.sensors)->default_value(cell.sensors), "sensors of the cell");
+  // clang-format on
+
+  po::variables_map vm;
+  try
+  {
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl << desc << std::endl;
+    return 1;
+  }
+  if (vm.count("help"))
+  {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  if (vm.count("seed"))
+  {
+    tree.seed = cell.seed = vm["seed"].as<std::uint64_t>();
+  }
+
+  const YAML::Node node = vm.count("robot-cell") ? cnr::yaml::generate_robot_cell(cell) : cnr::yaml::generate_tree(tree);
+
+  YAML::Emitter emitter;
+  emitter << node;
+  if (output.empty())
+  {
+    std::cout << emitter.c_str() << std::endl;
+  }
+  else
+  {
+    std::ofstream file(output);
+    if (!(file << emitter.c_str() << std::endl))
+    {
+      std::cerr << "Error in writing '" << output << "'" << std::endl;
+      return 1;
+    }
+  }
+  std::cerr << cnr::yaml::count_nodes(node) << " nodes, " << emitter.size() << " bytes" << std::endl;
+  return 0;
+}
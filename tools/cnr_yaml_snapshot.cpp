@@ -0,0 +1,50 @@
+#include <iostream>
+#include <string>
+#include <yaml-cpp/yaml.h>
+
+#include <cnr_yaml/snapshot.h>
+
+int main(int argc, char** argv)
+{
+  if (argc != 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " <input.yaml> <output.snapshot>" << std::endl;
+    std::cerr << "Convert a YAML file in a memory-mappable snapshot (see cnr_yaml/snapshot.h)" << std::endl;
+    return 1;
+  }
+
+  const std::string input = argv[1];
+  const std::string output = argv[2];
+  YAML::Node node;
+  try
+  {
+    node = YAML::LoadFile(input);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Error in loading '" << input << "': " << e.what() << std::endl;
+    return 1;
+  }
+
+  std::string what;
+  cnr::yaml::FrozenNode root;
+  try
+  {
+    root = cnr::yaml::FrozenNode(node);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Error in freezing '" << input << "': " << e.what() << std::endl;
+    return 1;
+  }
+  if (!cnr::yaml::save_snapshot(root, output, what))
+  {
+    std::cerr << what << std::endl;
+    return 1;
+  }
+
+  const auto& h = root.image()->header();
+  std::cout << output << ": " << h.size << " bytes, " << h.entries << " nodes, " << h.numbers << " numbers, "
+            << h.strings_size << " bytes of strings" << std::endl;
+  return 0;
+}